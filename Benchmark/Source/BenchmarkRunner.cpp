@@ -0,0 +1,233 @@
+/*
+  ==============================================================================
+
+    BenchmarkRunner.cpp
+    Created: 18 Oct 2026 12:14:37am
+    Author:  Adam Chung
+
+  ==============================================================================
+*/
+
+#include "BenchmarkRunner.h"
+
+//==============================================================================
+BenchmarkRunner::BenchmarkRunner()
+    : mProcessor (std::make_unique<BasicSamplerAudioProcessor>())
+{
+}
+
+BenchmarkRunner::~BenchmarkRunner()
+{
+    mProcessor->releaseResources();
+}
+
+bool BenchmarkRunner::loadInstrument (const juce::File& fileOrFolder, int storage)
+{
+    auto file = fileOrFolder == juce::File() ? writeSyntheticSample() : fileOrFolder;
+
+    if (!file.exists()) {
+        return false;
+    }
+
+    mInstrumentName = fileOrFolder == juce::File() ? juce::String ("synthetic") : file.getFullPathName();
+    setParameter ("STORAGE", static_cast<float> (storage));
+    mProcessor->loadFile (file.getFullPathName());
+
+    // The loader hands finished instruments over on the message thread
+    auto timeout = juce::Time::getMillisecondCounter() + 60000;
+
+    while (mProcessor->getNumZones() == 0 && juce::Time::getMillisecondCounter() < timeout) {
+        juce::MessageManager::getInstance()->runDispatchLoopUntil (10);
+    }
+
+    return mProcessor->getNumZones() > 0;
+}
+
+BenchmarkRunner::Result BenchmarkRunner::run (const Config& config)
+{
+    prepare (config);
+
+    auto script = makeScript (config);
+    auto totalSamples = static_cast<juce::int64> (config.seconds * config.sampleRate);
+
+    // Play the start untimed first, so the streamer, the caches and the render
+    // workers have settled before anything is measured
+    play (config, script, static_cast<juce::int64> (warmUpSeconds * config.sampleRate), nullptr);
+    stopAllNotes (config);
+
+    auto underrunsBefore = mProcessor->getNumStreamUnderruns();
+    std::vector<juce::int64> blockTicks;
+    play (config, script, totalSamples, &blockTicks);
+
+    Result result;
+    result.config = config;
+    result.numBlocks = static_cast<int> (blockTicks.size());
+    result.numUnderruns = mProcessor->getNumStreamUnderruns() - underrunsBefore;
+
+    stopAllNotes (config);
+
+    if (blockTicks.empty()) {
+        return result;
+    }
+
+    auto toMicros = [] (juce::int64 ticks) { return juce::Time::highResolutionTicksToSeconds (ticks) * 1.0e6; };
+    auto totalTicks = std::accumulate (blockTicks.begin(), blockTicks.end(), juce::int64 { 0 });
+    auto totalSeconds = juce::Time::highResolutionTicksToSeconds (totalTicks);
+
+    // Nearest rank
+    std::sort (blockTicks.begin(), blockTicks.end());
+    auto percentile = [&blockTicks] (double fraction) {
+        auto rank = static_cast<size_t> (std::ceil (fraction * static_cast<double> (blockTicks.size())));
+        return blockTicks[juce::jlimit<size_t> (1, blockTicks.size(), rank) - 1];
+    };
+
+    result.nanosPerSample = totalSeconds * 1.0e9 / static_cast<double> (totalSamples);
+    result.p50BlockMicros = toMicros (percentile (0.5));
+    result.p99BlockMicros = toMicros (percentile (0.99));
+    result.maxBlockMicros = toMicros (blockTicks.back());
+    result.realTimeFactor = totalSeconds > 0.0 ? (static_cast<double> (totalSamples) / config.sampleRate) / totalSeconds : 0.0;
+
+    return result;
+}
+
+//==============================================================================
+void BenchmarkRunner::setParameter (const juce::String& parameterId, float value)
+{
+    if (auto* parameter = mProcessor->getAPVTS().getParameter (parameterId)) {
+        parameter->setValueNotifyingHost (parameter->convertTo0to1 (value));
+    }
+}
+
+void BenchmarkRunner::prepare (const Config& config)
+{
+    setParameter ("POLYPHONY", static_cast<float> (config.polyphony));
+    setParameter ("RENDER_THREADS", static_cast<float> (config.renderThreads));
+    setParameter ("INTERPOLATION", static_cast<float> (config.interpolation));
+    setParameter ("FILTER_TYPE", static_cast<float> (config.filterType));
+
+    // A cutoff the filter envelope sweeps, so the coefficients keep changing through every note
+    setParameter ("FILTER_CUTOFF", 1000.0f);
+    setParameter ("FILTER_ENV_AMOUNT", 3.0f);
+
+    mProcessor->releaseResources();
+    mProcessor->setNonRealtime (config.offline);
+    mProcessor->setRateAndBufferSizeDetails (config.sampleRate, config.blockSize);
+    mProcessor->prepareToPlay (config.sampleRate, config.blockSize);
+}
+
+void BenchmarkRunner::play (const Config& config, const std::vector<ScriptEvent>& script,
+                            juce::int64 numSamples, std::vector<juce::int64>* blockTicks)
+{
+    juce::AudioBuffer<float> buffer (mProcessor->getTotalNumOutputChannels(), config.blockSize);
+    juce::MidiBuffer midi;
+    size_t nextEvent = 0;
+
+    if (blockTicks != nullptr) {
+        blockTicks->reserve (static_cast<size_t> (numSamples / config.blockSize + 1));
+    }
+
+    for (juce::int64 position = 0; position < numSamples; position += config.blockSize) {
+        auto numThisBlock = static_cast<int> (juce::jmin<juce::int64> (config.blockSize, numSamples - position));
+
+        midi.clear();
+
+        for (; nextEvent < script.size() && script[nextEvent].samplePosition < position + numThisBlock; ++nextEvent) {
+            midi.addEvent (script[nextEvent].message, static_cast<int> (script[nextEvent].samplePosition - position));
+        }
+
+        buffer.setSize (buffer.getNumChannels(), numThisBlock, false, false, true);
+        buffer.clear();
+
+        auto start = juce::Time::getHighResolutionTicks();
+        mProcessor->processBlock (buffer, midi);
+        auto ticks = juce::Time::getHighResolutionTicks() - start;
+
+        if (blockTicks != nullptr) {
+            blockTicks->push_back (ticks);
+        }
+    }
+}
+
+void BenchmarkRunner::stopAllNotes (const Config& config)
+{
+    juce::AudioBuffer<float> buffer (mProcessor->getTotalNumOutputChannels(), config.blockSize);
+    juce::MidiBuffer midi;
+
+    for (int channel = 1; channel <= 16; ++channel) {
+        midi.addEvent (juce::MidiMessage::allNotesOff (channel), 0);
+    }
+
+    // Render the release tails away, so the next run starts from a quiet synth
+    auto numBlocks = static_cast<int> (drainSeconds * config.sampleRate / config.blockSize) + 1;
+
+    for (int i = 0; i < numBlocks; ++i) {
+        buffer.clear();
+        mProcessor->processBlock (buffer, midi);
+        midi.clear();
+    }
+}
+
+//==============================================================================
+juce::File BenchmarkRunner::writeSyntheticSample()
+{
+    // Four seconds of a decaying, slightly detuned stereo tone, as 16-bit WAV
+    constexpr double sampleRate = 48000.0;
+    constexpr int numFrames = 4 * 48000;
+    constexpr double frequency = 261.63;
+
+    juce::AudioBuffer<float> tone (2, numFrames);
+
+    for (int ch = 0; ch < 2; ++ch) {
+        auto* samples = tone.getWritePointer (ch);
+        auto detune = ch == 0 ? 1.0 : 1.003;
+
+        for (int i = 0; i < numFrames; ++i) {
+            auto t = i / sampleRate;
+            auto value = 0.0;
+
+            for (int harmonic = 1; harmonic <= 8; ++harmonic) {
+                value += std::sin (juce::MathConstants<double>::twoPi * frequency * detune * harmonic * t) / harmonic;
+            }
+
+            samples[i] = static_cast<float> (0.3 * value * std::exp (-0.6 * t));
+        }
+    }
+
+    auto file = juce::File::getSpecialLocation (juce::File::tempDirectory).getChildFile ("BasicSamplerBenchmark.wav");
+    file.deleteFile();
+
+    juce::WavAudioFormat wav;
+    std::unique_ptr<juce::AudioFormatWriter> writer { wav.createWriterFor (new juce::FileOutputStream (file), sampleRate, 2, 16, {}, 0) };
+
+    if (writer == nullptr || !writer->writeFromAudioSampleBuffer (tone, 0, numFrames)) {
+        return {};
+    }
+
+    return file;
+}
+
+std::vector<BenchmarkRunner::ScriptEvent> BenchmarkRunner::makeScript (const Config& config)
+{
+    // A fixed seed, so every run and every build plays the same notes
+    juce::Random random (0x5eed);
+
+    auto totalSamples = static_cast<juce::int64> (config.seconds * config.sampleRate);
+    auto noteLength = static_cast<juce::int64> (noteSeconds * config.sampleRate);
+    auto interval = juce::jmax<juce::int64> (1, noteLength / juce::jmax (1, config.polyphony));
+
+    std::vector<ScriptEvent> script;
+
+    for (juce::int64 position = 0; position < totalSamples; position += interval) {
+        auto note = 36 + random.nextInt (61);
+        auto velocity = static_cast<juce::uint8> (40 + random.nextInt (88));
+
+        script.push_back ({ position, juce::MidiMessage::noteOn (1, note, velocity) });
+        script.push_back ({ position + noteLength, juce::MidiMessage::noteOff (1, note) });
+    }
+
+    std::stable_sort (script.begin(), script.end(), [] (const ScriptEvent& a, const ScriptEvent& b) {
+        return a.samplePosition < b.samplePosition;
+    });
+
+    return script;
+}
@@ -0,0 +1,92 @@
+/*
+  ==============================================================================
+
+    BenchmarkRunner.h
+    Created: 18 Oct 2026 12:14:37am
+    Author:  Adam Chung
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "../../Source/PluginProcessor.h"
+
+//==============================================================================
+/*
+    Drives a BasicSamplerAudioProcessor without an editor or an audio device,
+    timing every processBlock call.
+
+    Every run plays the same MIDI script, worked out in samples from the run's
+    sample rate: note-ons at a steady rate with random keys and velocities,
+    each held for noteSeconds, so about as many notes sound at once as the
+    run has voices. Block size doesn't change which events land where, so
+    runs that only differ in block size play exactly the same music.
+*/
+class BenchmarkRunner
+{
+public:
+    struct Config
+    {
+        double sampleRate { 48000.0 };
+        int blockSize { 256 };
+        int polyphony { 32 };
+        int renderThreads { 1 };
+        int interpolation { 0 };
+        bool offline { false };   // rendered as a bounce, see isNonRealtime()
+        int filterType { 0 };     // index into the FILTER_TYPE choices, 0 is off
+        double seconds { 10.0 };
+    };
+
+    struct Result
+    {
+        Config config;
+        int numBlocks { 0 };
+        double nanosPerSample { 0.0 };
+        double p50BlockMicros { 0.0 };
+        double p99BlockMicros { 0.0 };
+        double maxBlockMicros { 0.0 };
+        double realTimeFactor { 0.0 };   // seconds of audio rendered per second of processing
+        int numUnderruns { 0 };
+    };
+
+    BenchmarkRunner();
+    ~BenchmarkRunner();
+
+    // Message thread. Loads an audio file, SFZ or folder, or when given an empty
+    // File, a synthetic sample written to the temp folder. Pumps the message
+    // loop until the loader hands the instrument over.
+    bool loadInstrument (const juce::File& fileOrFolder, int storage);
+
+    Result run (const Config& config);
+
+    juce::String getInstrumentName() const { return mInstrumentName; }
+
+    static constexpr double noteSeconds { 1.0 };
+    static constexpr double warmUpSeconds { 1.0 };
+    static constexpr double drainSeconds { 5.0 };
+
+private:
+    struct ScriptEvent
+    {
+        juce::int64 samplePosition;
+        juce::MidiMessage message;
+    };
+
+    void setParameter (const juce::String& parameterId, float value);
+    void prepare (const Config& config);
+
+    // Plays the script's first numSamples, timing each block into blockTicks if given
+    void play (const Config& config, const std::vector<ScriptEvent>& script,
+               juce::int64 numSamples, std::vector<juce::int64>* blockTicks);
+    void stopAllNotes (const Config& config);
+
+    static juce::File writeSyntheticSample();
+    static std::vector<ScriptEvent> makeScript (const Config& config);
+
+    std::unique_ptr<BasicSamplerAudioProcessor> mProcessor;
+    juce::String mInstrumentName;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BenchmarkRunner)
+};
@@ -0,0 +1,180 @@
+/*
+  ==============================================================================
+
+    This file contains the basic startup code for a JUCE application.
+
+    Headless benchmark of the sampler engine. Runs every combination of the
+    given sample rates, block sizes and polyphonies and reports ns per sample,
+    per-block p50/p99/max latency and the real-time factor of each, optionally
+    as JSON to diff between builds. Built in the RTCheck configuration it
+    exits with 2, and a report, if the audio thread did anything that isn't
+    realtime safe.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "BenchmarkRunner.h"
+#include "../../Source/RealtimeChecker.h"
+
+namespace
+{
+    const char* const usage =
+        "SamplerBenchmark [options]\n"
+        "  --sample <path>            audio file, SFZ or folder to load, a synthetic tone if not given\n"
+        "  --sample-rates <list>      comma separated, default 48000\n"
+        "  --block-sizes <list>       comma separated, default 64,256,1024\n"
+        "  --polyphony <list>         comma separated, default 8,32,128\n"
+        "  --render-threads <n>       default 1\n"
+        "  --interpolation <n>        index into the INTERPOLATION choices, default 0\n"
+        "  --storage <n>              index into the STORAGE choices, default 0\n"
+        "  --offline                  render as a bounce: every core, best interpolation\n"
+        "  --filter <n>               index into the FILTER_TYPE choices, default 0 (off)\n"
+        "  --seconds <s>              audio rendered per run, default 10\n"
+        "  --json <path>              also write the results as JSON, - for stdout\n"
+        "  --unit-tests               run the sampler's unit tests instead, needs JUCE_UNIT_TESTS\n";
+
+    std::vector<double> parseList (const juce::String& text, const juce::String& fallback)
+    {
+        std::vector<double> values;
+
+        for (auto& token : juce::StringArray::fromTokens (text.isEmpty() ? fallback : text, ",", {})) {
+            if (auto value = token.trim().getDoubleValue(); value > 0.0) {
+                values.push_back (value);
+            }
+        }
+
+        return values;
+    }
+
+    juce::var toJson (const BenchmarkRunner::Result& result)
+    {
+        auto* object = new juce::DynamicObject();
+        object->setProperty ("sampleRate", result.config.sampleRate);
+        object->setProperty ("blockSize", result.config.blockSize);
+        object->setProperty ("polyphony", result.config.polyphony);
+        object->setProperty ("renderThreads", result.config.renderThreads);
+        object->setProperty ("interpolation", result.config.interpolation);
+        object->setProperty ("offline", result.config.offline);
+        object->setProperty ("filterType", result.config.filterType);
+        object->setProperty ("seconds", result.config.seconds);
+        object->setProperty ("blocks", result.numBlocks);
+        object->setProperty ("nsPerSample", result.nanosPerSample);
+        object->setProperty ("p50BlockMicros", result.p50BlockMicros);
+        object->setProperty ("p99BlockMicros", result.p99BlockMicros);
+        object->setProperty ("maxBlockMicros", result.maxBlockMicros);
+        object->setProperty ("realTimeFactor", result.realTimeFactor);
+        object->setProperty ("underruns", result.numUnderruns);
+        return object;
+    }
+}
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    juce::ArgumentList args (argc, argv);
+
+    if (args.containsOption ("--help|-h")) {
+        std::cout << usage;
+        return 0;
+    }
+
+    // The loader hands instruments over through the message loop
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    if (args.containsOption ("--unit-tests")) {
+        juce::UnitTestRunner tests;
+        tests.runTestsInCategory ("BasicSampler");
+
+        int numFailures = 0;
+
+        for (int i = 0; i < tests.getNumResults(); ++i) {
+            numFailures += tests.getResult (i)->failures;
+        }
+
+        return numFailures > 0 ? 1 : 0;
+    }
+
+    auto samplePath = args.getValueForOption ("--sample");
+    auto sampleRates = parseList (args.getValueForOption ("--sample-rates"), "48000");
+    auto blockSizes = parseList (args.getValueForOption ("--block-sizes"), "64,256,1024");
+    auto polyphonies = parseList (args.getValueForOption ("--polyphony"), "8,32,128");
+    auto jsonPath = args.getValueForOption ("--json");
+
+    BenchmarkRunner::Config base;
+    base.renderThreads = juce::jmax (1, args.getValueForOption ("--render-threads").getIntValue());
+    base.interpolation = juce::jmax (0, args.getValueForOption ("--interpolation").getIntValue());
+    base.offline = args.containsOption ("--offline");
+    base.filterType = juce::jmax (0, args.getValueForOption ("--filter").getIntValue());
+    base.seconds = args.containsOption ("--seconds") ? args.getValueForOption ("--seconds").getDoubleValue() : base.seconds;
+    auto storage = juce::jmax (0, args.getValueForOption ("--storage").getIntValue());
+
+    BenchmarkRunner runner;
+
+    if (!runner.loadInstrument (samplePath.isEmpty() ? juce::File() : juce::File::getCurrentWorkingDirectory().getChildFile (samplePath), storage)) {
+        std::cerr << "Couldn't load " << (samplePath.isEmpty() ? juce::String ("the synthetic sample") : samplePath) << std::endl;
+        return 1;
+    }
+
+    std::cout << "instrument: " << runner.getInstrumentName() << "\n"
+              << "  rate  block  poly    ns/sample    p50 us    p99 us    max us       RTF  underruns\n";
+
+    juce::Array<juce::var> results;
+
+    for (auto sampleRate : sampleRates) {
+        for (auto blockSize : blockSizes) {
+            for (auto polyphony : polyphonies) {
+                auto config = base;
+                config.sampleRate = sampleRate;
+                config.blockSize = static_cast<int> (blockSize);
+                config.polyphony = static_cast<int> (polyphony);
+
+                auto result = runner.run (config);
+                results.add (toJson (result));
+
+                std::cout << juce::String (sampleRate, 0).paddedLeft (' ', 6)
+                          << juce::String (config.blockSize).paddedLeft (' ', 7)
+                          << juce::String (config.polyphony).paddedLeft (' ', 6)
+                          << juce::String (result.nanosPerSample, 2).paddedLeft (' ', 13)
+                          << juce::String (result.p50BlockMicros, 1).paddedLeft (' ', 10)
+                          << juce::String (result.p99BlockMicros, 1).paddedLeft (' ', 10)
+                          << juce::String (result.maxBlockMicros, 1).paddedLeft (' ', 10)
+                          << juce::String (result.realTimeFactor, 1).paddedLeft (' ', 10)
+                          << juce::String (result.numUnderruns).paddedLeft (' ', 11) << std::endl;
+            }
+        }
+    }
+
+    if (jsonPath.isNotEmpty()) {
+        auto* report = new juce::DynamicObject();
+        report->setProperty ("benchmark", "SamplerBenchmark");
+        report->setProperty ("formatVersion", 1);
+       #if JUCE_DEBUG
+        report->setProperty ("build", "Debug");
+       #else
+        report->setProperty ("build", "Release");
+       #endif
+        report->setProperty ("juce", juce::SystemStats::getJUCEVersion());
+        report->setProperty ("cpu", juce::SystemStats::getCpuModel());
+        report->setProperty ("numCpus", juce::SystemStats::getNumCpus());
+        report->setProperty ("instrument", runner.getInstrumentName());
+        report->setProperty ("results", results);
+
+        auto json = juce::JSON::toString (juce::var (report));
+
+        if (jsonPath == "-") {
+            std::cout << json << std::endl;
+        } else if (!juce::File::getCurrentWorkingDirectory().getChildFile (jsonPath).replaceWithText (json)) {
+            std::cerr << "Couldn't write " << jsonPath << std::endl;
+            return 1;
+        }
+    }
+
+    // RT check builds fail the run if the audio thread did anything it shouldn't
+    if (RealtimeChecker::compiledIn && RealtimeChecker::getNumViolations() > 0) {
+        std::cerr << RealtimeChecker::takeReport() << std::endl;
+        return 2;
+    }
+
+    return 0;
+}
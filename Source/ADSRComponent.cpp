@@ -1,104 +1,104 @@
-/*
-  ==============================================================================
-
-    ADSRComponent.cpp
-    Created: 4 Feb 2024 6:41:47pm
-    Author:  Adam Chung
-
-  ==============================================================================
-*/
-
-#include <JuceHeader.h>
-#include "ADSRComponent.h"
-
-//==============================================================================
-ADSRComponent::ADSRComponent(BasicSamplerAudioProcessor& p) : audioProcessor(p)
-{
-    // Attack Slider
-    mAttackSlider.setSliderStyle(juce::Slider::SliderStyle::RotaryVerticalDrag);
-    mAttackSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, true, 40, 20);
-    mAttackSlider.setColour(juce::Slider::ColourIds::textBoxTextColourId, juce::Colours::black);
-    mAttackSlider.setColour(juce::Slider::ColourIds::thumbColourId, juce::Colours::red);
-    mAttackSlider.setRange(0.0f, 5.0f, 0.01f);
-    addAndMakeVisible(mAttackSlider);
-    
-    mAttackLabel.setFont(10.0f);
-    mAttackLabel.setText("Attack", juce::NotificationType::dontSendNotification);
-    mAttackLabel.setColour(juce::Label::ColourIds::textColourId, juce::Colours::black);
-    mAttackLabel.setJustificationType(juce::Justification::centred);
-    mAttackLabel.attachToComponent(&mAttackSlider, false);
-    
-    mAttackAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(audioProcessor.getAPVTS(), "ATTACK", mAttackSlider);
-    
-    // Decay Slider
-    mDecaySlider.setSliderStyle(juce::Slider::SliderStyle::RotaryVerticalDrag);
-    mDecaySlider.setTextBoxStyle(juce::Slider::TextBoxBelow, true, 40, 20);
-    mDecaySlider.setColour(juce::Slider::ColourIds::textBoxTextColourId, juce::Colours::black);
-    mDecaySlider.setColour(juce::Slider::ColourIds::thumbColourId, juce::Colours::red);
-    mDecaySlider.setRange(0.0f, 5.0f, 0.01f);
-    addAndMakeVisible(mDecaySlider);
-    
-    mDecayLabel.setFont(10.0f);
-    mDecayLabel.setText("Decay", juce::NotificationType::dontSendNotification);
-    mDecayLabel.setColour(juce::Label::ColourIds::textColourId, juce::Colours::black);
-    mDecayLabel.setJustificationType(juce::Justification::centred);
-    mDecayLabel.attachToComponent(&mDecaySlider, false);
-    
-    mDecayAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(audioProcessor.getAPVTS(), "DECAY", mDecaySlider);
-    
-    // Sustain Slider
-    mSustainSlider.setSliderStyle(juce::Slider::SliderStyle::RotaryVerticalDrag);
-    mSustainSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, true, 40, 20);
-    mSustainSlider.setColour(juce::Slider::ColourIds::textBoxTextColourId, juce::Colours::black);
-    mSustainSlider.setColour(juce::Slider::ColourIds::thumbColourId, juce::Colours::red);
-    mSustainSlider.setRange(0.0f, 1.0f, 0.01f);
-    addAndMakeVisible(mSustainSlider);
-    
-    mSustainLabel.setFont(10.0f);
-    mSustainLabel.setText("Sustain", juce::NotificationType::dontSendNotification);
-    mSustainLabel.setColour(juce::Label::ColourIds::textColourId, juce::Colours::black);
-    mSustainLabel.setJustificationType(juce::Justification::centred);
-    mSustainLabel.attachToComponent(&mSustainSlider, false);
-    
-    mSustainAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(audioProcessor.getAPVTS(), "SUSTAIN", mSustainSlider);
-    
-    // Release Slider
-    mReleaseSlider.setSliderStyle(juce::Slider::SliderStyle::RotaryVerticalDrag);
-    mReleaseSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, true, 40, 20);
-    mReleaseSlider.setColour(juce::Slider::ColourIds::textBoxTextColourId, juce::Colours::black);
-    mReleaseSlider.setColour(juce::Slider::ColourIds::thumbColourId, juce::Colours::red);
-    mReleaseSlider.setRange(0.0f, 5.0f, 0.01f);
-    addAndMakeVisible(mReleaseSlider);
-    
-    mReleaseLabel.setFont(10.0f);
-    mReleaseLabel.setText("Release", juce::NotificationType::dontSendNotification);
-    mReleaseLabel.setColour(juce::Label::ColourIds::textColourId, juce::Colours::black);
-    mReleaseLabel.setJustificationType(juce::Justification::centred);
-    mReleaseLabel.attachToComponent(&mReleaseSlider, false);
-    
-    mReleaseAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(audioProcessor.getAPVTS(), "RELEASE", mReleaseSlider);
-
-}
-
-ADSRComponent::~ADSRComponent()
-{
-}
-
-void ADSRComponent::paint (juce::Graphics& g)
-{
-    g.fillAll(juce::Colours::white);
-}
-
-void ADSRComponent::resized()
-{
-    const auto startX = 0.6f;
-    const auto startY = 0.2f;
-    const auto dialWidth = 0.1f;
-    const auto dialHeight = 0.75f;
-    
-    mAttackSlider.setBoundsRelative(startX, startY, dialWidth, dialHeight);
-    mDecaySlider.setBoundsRelative(startX + (dialWidth * 1), startY, dialWidth, dialHeight);
-    mSustainSlider.setBoundsRelative(startX + (dialWidth * 2), startY, dialWidth, dialHeight);
-    mReleaseSlider.setBoundsRelative(startX + (dialWidth * 3), startY, dialWidth, dialHeight);
-
-}
+/*
+  ==============================================================================
+
+    ADSRComponent.cpp
+    Created: 4 Feb 2024 6:41:47pm
+    Author:  Adam Chung
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "ADSRComponent.h"
+
+//==============================================================================
+ADSRComponent::ADSRComponent(BasicSamplerAudioProcessor& p) : audioProcessor(p)
+{
+    // Attack Slider
+    mAttackSlider.setSliderStyle(juce::Slider::SliderStyle::RotaryVerticalDrag);
+    mAttackSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, true, 40, 20);
+    mAttackSlider.setColour(juce::Slider::ColourIds::textBoxTextColourId, juce::Colours::black);
+    mAttackSlider.setColour(juce::Slider::ColourIds::thumbColourId, juce::Colours::red);
+    mAttackSlider.setRange(0.0f, 5.0f, 0.01f);
+    addAndMakeVisible(mAttackSlider);
+    
+    mAttackLabel.setFont(10.0f);
+    mAttackLabel.setText("Attack", juce::NotificationType::dontSendNotification);
+    mAttackLabel.setColour(juce::Label::ColourIds::textColourId, juce::Colours::black);
+    mAttackLabel.setJustificationType(juce::Justification::centred);
+    mAttackLabel.attachToComponent(&mAttackSlider, false);
+    
+    mAttackAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(audioProcessor.getAPVTS(), "ATTACK", mAttackSlider);
+    
+    // Decay Slider
+    mDecaySlider.setSliderStyle(juce::Slider::SliderStyle::RotaryVerticalDrag);
+    mDecaySlider.setTextBoxStyle(juce::Slider::TextBoxBelow, true, 40, 20);
+    mDecaySlider.setColour(juce::Slider::ColourIds::textBoxTextColourId, juce::Colours::black);
+    mDecaySlider.setColour(juce::Slider::ColourIds::thumbColourId, juce::Colours::red);
+    mDecaySlider.setRange(0.0f, 5.0f, 0.01f);
+    addAndMakeVisible(mDecaySlider);
+    
+    mDecayLabel.setFont(10.0f);
+    mDecayLabel.setText("Decay", juce::NotificationType::dontSendNotification);
+    mDecayLabel.setColour(juce::Label::ColourIds::textColourId, juce::Colours::black);
+    mDecayLabel.setJustificationType(juce::Justification::centred);
+    mDecayLabel.attachToComponent(&mDecaySlider, false);
+    
+    mDecayAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(audioProcessor.getAPVTS(), "DECAY", mDecaySlider);
+    
+    // Sustain Slider
+    mSustainSlider.setSliderStyle(juce::Slider::SliderStyle::RotaryVerticalDrag);
+    mSustainSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, true, 40, 20);
+    mSustainSlider.setColour(juce::Slider::ColourIds::textBoxTextColourId, juce::Colours::black);
+    mSustainSlider.setColour(juce::Slider::ColourIds::thumbColourId, juce::Colours::red);
+    mSustainSlider.setRange(0.0f, 1.0f, 0.01f);
+    addAndMakeVisible(mSustainSlider);
+    
+    mSustainLabel.setFont(10.0f);
+    mSustainLabel.setText("Sustain", juce::NotificationType::dontSendNotification);
+    mSustainLabel.setColour(juce::Label::ColourIds::textColourId, juce::Colours::black);
+    mSustainLabel.setJustificationType(juce::Justification::centred);
+    mSustainLabel.attachToComponent(&mSustainSlider, false);
+    
+    mSustainAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(audioProcessor.getAPVTS(), "SUSTAIN", mSustainSlider);
+    
+    // Release Slider
+    mReleaseSlider.setSliderStyle(juce::Slider::SliderStyle::RotaryVerticalDrag);
+    mReleaseSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, true, 40, 20);
+    mReleaseSlider.setColour(juce::Slider::ColourIds::textBoxTextColourId, juce::Colours::black);
+    mReleaseSlider.setColour(juce::Slider::ColourIds::thumbColourId, juce::Colours::red);
+    mReleaseSlider.setRange(0.0f, 5.0f, 0.01f);
+    addAndMakeVisible(mReleaseSlider);
+    
+    mReleaseLabel.setFont(10.0f);
+    mReleaseLabel.setText("Release", juce::NotificationType::dontSendNotification);
+    mReleaseLabel.setColour(juce::Label::ColourIds::textColourId, juce::Colours::black);
+    mReleaseLabel.setJustificationType(juce::Justification::centred);
+    mReleaseLabel.attachToComponent(&mReleaseSlider, false);
+    
+    mReleaseAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(audioProcessor.getAPVTS(), "RELEASE", mReleaseSlider);
+
+}
+
+ADSRComponent::~ADSRComponent()
+{
+}
+
+void ADSRComponent::paint (juce::Graphics& g)
+{
+    g.fillAll(juce::Colours::white);
+}
+
+void ADSRComponent::resized()
+{
+    const auto startX = 0.6f;
+    const auto startY = 0.2f;
+    const auto dialWidth = 0.1f;
+    const auto dialHeight = 0.75f;
+    
+    mAttackSlider.setBoundsRelative(startX, startY, dialWidth, dialHeight);
+    mDecaySlider.setBoundsRelative(startX + (dialWidth * 1), startY, dialWidth, dialHeight);
+    mSustainSlider.setBoundsRelative(startX + (dialWidth * 2), startY, dialWidth, dialHeight);
+    mReleaseSlider.setBoundsRelative(startX + (dialWidth * 3), startY, dialWidth, dialHeight);
+
+}
@@ -1,47 +1,47 @@
-/*
-  ==============================================================================
-
-    ADSRComponent.h
-    Created: 4 Feb 2024 6:41:47pm
-    Author:  Adam Chung
-
-  ==============================================================================
-*/
-
-#pragma once
-
-#include <JuceHeader.h>
-#include "PluginProcessor.h"
-
-//==============================================================================
-/*
-*/
-class ADSRComponent  : public juce::Component
-{
-public:
-    ADSRComponent(BasicSamplerAudioProcessor& p);
-    ~ADSRComponent() override;
-
-    void paint (juce::Graphics&) override;
-    void resized() override;
-
-private:
-    juce::Slider mAttackSlider,
-                 mDecaySlider,
-                 mSustainSlider,
-                 mReleaseSlider;
-    
-    juce::Label mAttackLabel,
-                mDecayLabel,
-                mSustainLabel,
-                mReleaseLabel;
-    
-    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> mAttackAttachment;
-    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> mDecayAttachment;
-    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> mSustainAttachment;
-    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> mReleaseAttachment;
-    
-    BasicSamplerAudioProcessor& audioProcessor;
-    
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ADSRComponent)
-};
+/*
+  ==============================================================================
+
+    ADSRComponent.h
+    Created: 4 Feb 2024 6:41:47pm
+    Author:  Adam Chung
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+
+//==============================================================================
+/*
+*/
+class ADSRComponent  : public juce::Component
+{
+public:
+    ADSRComponent(BasicSamplerAudioProcessor& p);
+    ~ADSRComponent() override;
+
+    void paint (juce::Graphics&) override;
+    void resized() override;
+
+private:
+    juce::Slider mAttackSlider,
+                 mDecaySlider,
+                 mSustainSlider,
+                 mReleaseSlider;
+    
+    juce::Label mAttackLabel,
+                mDecayLabel,
+                mSustainLabel,
+                mReleaseLabel;
+    
+    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> mAttackAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> mDecayAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> mSustainAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> mReleaseAttachment;
+    
+    BasicSamplerAudioProcessor& audioProcessor;
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ADSRComponent)
+};
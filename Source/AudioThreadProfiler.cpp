@@ -0,0 +1,231 @@
+/*
+  ==============================================================================
+
+    AudioThreadProfiler.cpp
+    Created: 18 Oct 2026 12:41:05am
+    Author:  Adam Chung
+
+  ==============================================================================
+*/
+
+#include "AudioThreadProfiler.h"
+
+//==============================================================================
+void AudioThreadProfiler::Histogram::add (double micros)
+{
+    auto bucket = micros > 1.0 ? static_cast<int> (std::floor (4.0 * std::log2 (micros))) : 0;
+    ++counts[static_cast<size_t> (juce::jlimit (0, numBuckets - 1, bucket))];
+    ++numValues;
+    maxMicros = juce::jmax (maxMicros, micros);
+    sumMicros += micros;
+}
+
+double AudioThreadProfiler::Histogram::getPercentileMicros (double fraction) const
+{
+    if (numValues == 0) {
+        return 0.0;
+    }
+
+    auto rank = static_cast<juce::uint64> (std::ceil (fraction * static_cast<double> (numValues)));
+    juce::uint64 seen = 0;
+
+    for (int i = 0; i < numBuckets; ++i) {
+        seen += counts[static_cast<size_t> (i)];
+
+        if (seen >= rank) {
+            return juce::jmin (maxMicros, getBucketUpperMicros (i));
+        }
+    }
+
+    return maxMicros;
+}
+
+//==============================================================================
+const char* AudioThreadProfiler::getStageName (Stage stage)
+{
+    switch (stage) {
+        case zoneSwap:   return "zone swap";
+        case parameters: return "parameters";
+        case render:     return "render";
+        case total:      return "total";
+        case numStages:  break;
+    }
+
+    return "";
+}
+
+AudioThreadProfiler::AudioThreadProfiler()
+{
+    mStatistics.recentOverruns.reserve (maxRecentOverruns);
+}
+
+AudioThreadProfiler::~AudioThreadProfiler()
+{
+    stopTimer();
+}
+
+void AudioThreadProfiler::setEnabled (bool shouldBeEnabled)
+{
+    mEnabled.store (compiledIn && shouldBeEnabled);
+
+    // The collector only runs while there's something to collect
+    if (isEnabled()) {
+        startTimerHz (10);
+    } else {
+        timerCallback();
+        stopTimer();
+    }
+}
+
+//==============================================================================
+void AudioThreadProfiler::endBlock (int numVoices, int numMidiEvents, int numParameterChanges, int totalUnderruns)
+{
+    if (!mMeasuring) {
+        return;
+    }
+
+    mRecord.ticks[total] = static_cast<juce::uint32> (juce::Time::getHighResolutionTicks() - mBlockStart);
+    mRecord.numVoices = static_cast<juce::uint16> (numVoices);
+    mRecord.numMidiEvents = static_cast<juce::uint16> (juce::jmin (numMidiEvents, 0xffff));
+    mRecord.numParameterChanges = static_cast<juce::uint16> (numParameterChanges);
+    mRecord.totalUnderruns = static_cast<juce::uint32> (totalUnderruns);
+
+    int start1, size1, start2, size2;
+    mFifo.prepareToWrite (1, start1, size1, start2, size2);
+
+    if (size1 + size2 == 0) {
+        // The collector has fallen behind, better to lose a record than to wait
+        mNumDropped.fetch_add (1, std::memory_order_relaxed);
+        return;
+    }
+
+    mRecords[static_cast<size_t> (size1 > 0 ? start1 : start2)] = mRecord;
+    mFifo.finishedWrite (1);
+}
+
+//==============================================================================
+void AudioThreadProfiler::timerCallback()
+{
+    const juce::ScopedLock sl (mStatisticsLock);
+
+    int start1, size1, start2, size2;
+    mFifo.prepareToRead (mFifo.getNumReady(), start1, size1, start2, size2);
+
+    for (int i = 0; i < size1; ++i) {
+        collect (mRecords[static_cast<size_t> (start1 + i)]);
+    }
+
+    for (int i = 0; i < size2; ++i) {
+        collect (mRecords[static_cast<size_t> (start2 + i)]);
+    }
+
+    mFifo.finishedRead (size1 + size2);
+
+    mStatistics.numDropped = mNumDropped.load (std::memory_order_relaxed);
+}
+
+void AudioThreadProfiler::collect (const BlockRecord& record)
+{
+    auto toMicros = [] (juce::uint32 ticks) { return juce::Time::highResolutionTicksToSeconds (static_cast<juce::int64> (ticks)) * 1.0e6; };
+
+    auto& statistics = mStatistics;
+
+    for (int stage = 0; stage < numStages; ++stage) {
+        statistics.stages[static_cast<size_t> (stage)].add (toMicros (record.ticks[static_cast<size_t> (stage)]));
+    }
+
+    ++statistics.numBlocks;
+
+    mVoiceSum += record.numVoices;
+    mMidiEventSum += record.numMidiEvents;
+    statistics.maxVoices = juce::jmax (statistics.maxVoices, static_cast<int> (record.numVoices));
+    statistics.maxMidiEvents = juce::jmax (statistics.maxMidiEvents, static_cast<int> (record.numMidiEvents));
+    statistics.meanVoices = static_cast<double> (mVoiceSum) / static_cast<double> (statistics.numBlocks);
+    statistics.meanMidiEvents = static_cast<double> (mMidiEventSum) / static_cast<double> (statistics.numBlocks);
+    statistics.numParameterChanges += record.numParameterChanges;
+
+    if (record.totalUnderruns > mLastUnderruns && statistics.numBlocks > 1) {
+        statistics.numUnderruns += record.totalUnderruns - mLastUnderruns;
+    }
+
+    mLastUnderruns = record.totalUnderruns;
+
+    // A block that took longer than the audio it produced would have been an xrun
+    auto budgetMicros = record.numSamples * 1.0e6 / mSampleRate.load();
+
+    if (toMicros (record.ticks[total]) > budgetMicros) {
+        ++statistics.numOverruns;
+
+        if (statistics.recentOverruns.size() == maxRecentOverruns) {
+            statistics.recentOverruns.erase (statistics.recentOverruns.begin());
+        }
+
+        statistics.recentOverruns.push_back (record);
+    }
+}
+
+AudioThreadProfiler::Statistics AudioThreadProfiler::getStatistics() const
+{
+    const juce::ScopedLock sl (mStatisticsLock);
+    return mStatistics;
+}
+
+void AudioThreadProfiler::reset()
+{
+    const juce::ScopedLock sl (mStatisticsLock);
+
+    mStatistics = {};
+    mStatistics.recentOverruns.reserve (maxRecentOverruns);
+    mVoiceSum = 0;
+    mMidiEventSum = 0;
+    mNumDropped.store (0);
+}
+
+bool AudioThreadProfiler::dumpToFile (const juce::File& file) const
+{
+    auto statistics = getStatistics();
+    juce::String report;
+
+    report << "BasicSampler audio thread profile, " << juce::Time::getCurrentTime().toString (true, true) << juce::newLine
+           << "sample rate " << mSampleRate.load() << ", blocks " << juce::String (statistics.numBlocks)
+           << ", overruns " << juce::String (statistics.numOverruns)
+           << ", dropped " << juce::String (statistics.numDropped)
+           << ", stream underruns " << juce::String (statistics.numUnderruns) << juce::newLine
+           << "voices mean " << juce::String (statistics.meanVoices, 1) << " max " << statistics.maxVoices
+           << ", MIDI events mean " << juce::String (statistics.meanMidiEvents, 1) << " max " << statistics.maxMidiEvents
+           << ", parameter changes " << juce::String (statistics.numParameterChanges) << juce::newLine << juce::newLine;
+
+    for (int stage = 0; stage < numStages; ++stage) {
+        const auto& histogram = statistics.stages[static_cast<size_t> (stage)];
+        auto mean = histogram.numValues > 0 ? histogram.sumMicros / static_cast<double> (histogram.numValues) : 0.0;
+
+        report << getStageName (static_cast<Stage> (stage)) << ": mean " << juce::String (mean, 1)
+               << "us, p50 " << juce::String (histogram.getPercentileMicros (0.5), 1)
+               << "us, p99 " << juce::String (histogram.getPercentileMicros (0.99), 1)
+               << "us, max " << juce::String (histogram.maxMicros, 1) << "us" << juce::newLine;
+
+        for (int i = 0; i < Histogram::numBuckets; ++i) {
+            if (auto count = histogram.counts[static_cast<size_t> (i)]) {
+                report << "  <= " << juce::String (Histogram::getBucketUpperMicros (i), 1).paddedLeft (' ', 9)
+                       << "us  " << juce::String (count) << juce::newLine;
+            }
+        }
+
+        report << juce::newLine;
+    }
+
+    report << "recent overruns (samples, voices, MIDI events, parameter changes, stage us):" << juce::newLine;
+
+    for (const auto& record : statistics.recentOverruns) {
+        report << "  " << static_cast<int> (record.numSamples) << ", " << static_cast<int> (record.numVoices)
+               << ", " << static_cast<int> (record.numMidiEvents) << ", " << static_cast<int> (record.numParameterChanges);
+
+        for (auto ticks : record.ticks) {
+            report << ", " << juce::String (juce::Time::highResolutionTicksToSeconds (static_cast<juce::int64> (ticks)) * 1.0e6, 1);
+        }
+
+        report << juce::newLine;
+    }
+
+    return file.replaceWithText (report);
+}
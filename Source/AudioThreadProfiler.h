@@ -0,0 +1,178 @@
+/*
+  ==============================================================================
+
+    AudioThreadProfiler.h
+    Created: 18 Oct 2026 12:41:05am
+    Author:  Adam Chung
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Set to 0 to compile every timing scope out of the audio thread
+#ifndef BASICSAMPLER_PROFILING
+ #define BASICSAMPLER_PROFILING 1
+#endif
+
+//==============================================================================
+/*
+    Times the stages of every processBlock call and counts what happened in
+    it, to find out why an instance overruns.
+
+    The audio thread fills in one BlockRecord per block and pushes it into a
+    single-producer, single-consumer FIFO, never blocking or allocating: if
+    the FIFO is full the record is dropped and counted. A timer on the message
+    thread drains the FIFO into per-stage histograms, and keeps the records of
+    the latest blocks that took longer than their own duration.
+
+    While disabled, a block costs the audio thread one relaxed load.
+*/
+class AudioThreadProfiler  : private juce::Timer
+{
+public:
+    enum Stage
+    {
+        zoneSwap,
+        parameters,
+        render,
+        total,
+        numStages
+    };
+
+    static const char* getStageName (Stage stage);
+
+    struct BlockRecord
+    {
+        std::array<juce::uint32, numStages> ticks {};
+        juce::uint16 numSamples { 0 };
+        juce::uint16 numVoices { 0 };
+        juce::uint16 numMidiEvents { 0 };
+        juce::uint16 numParameterChanges { 0 };
+        juce::uint32 totalUnderruns { 0 };   // running count, the collector takes the difference
+    };
+
+    // Block times in quarter octaves from 1us up to 65ms
+    struct Histogram
+    {
+        static constexpr int numBuckets { 64 };
+
+        static double getBucketUpperMicros (int bucket) { return std::exp2 ((bucket + 1) / 4.0); }
+
+        void add (double micros);
+        double getPercentileMicros (double fraction) const;
+
+        std::array<juce::uint64, numBuckets> counts {};
+        juce::uint64 numValues { 0 };
+        double maxMicros { 0.0 };
+        double sumMicros { 0.0 };
+    };
+
+    struct Statistics
+    {
+        std::array<Histogram, numStages> stages;
+        juce::uint64 numBlocks { 0 };
+        juce::uint64 numOverruns { 0 };
+        juce::uint64 numDropped { 0 };
+        juce::uint64 numUnderruns { 0 };
+        int maxVoices { 0 };
+        int maxMidiEvents { 0 };
+        double meanVoices { 0.0 };
+        double meanMidiEvents { 0.0 };
+        juce::uint64 numParameterChanges { 0 };
+
+        // The latest overrunning blocks, oldest first
+        std::vector<BlockRecord> recentOverruns;
+    };
+
+    AudioThreadProfiler();
+    ~AudioThreadProfiler() override;
+
+    //==============================================================================
+    // Message thread, starts or stops the collector along with the measuring
+    void setEnabled (bool shouldBeEnabled);
+
+    bool isEnabled() const { return mEnabled.load (std::memory_order_relaxed); }
+    void setSampleRate (double sampleRate) { mSampleRate.store (sampleRate); }
+
+    //==============================================================================
+    // Audio thread
+    void beginBlock (int numSamples)
+    {
+        mMeasuring = compiledIn && mEnabled.load (std::memory_order_relaxed);
+
+        if (mMeasuring) {
+            mRecord = {};
+            mRecord.numSamples = static_cast<juce::uint16> (juce::jmin (numSamples, 0xffff));
+            mBlockStart = juce::Time::getHighResolutionTicks();
+        }
+    }
+
+    // Only worth collecting the counters for endBlock() when this is true
+    bool isMeasuring() const { return mMeasuring; }
+
+    void endBlock (int numVoices, int numMidiEvents, int numParameterChanges, int totalUnderruns);
+
+    class ScopedStage
+    {
+    public:
+        ScopedStage (AudioThreadProfiler& p, Stage s)
+            : profiler (p), stage (s), start (p.mMeasuring ? juce::Time::getHighResolutionTicks() : 0)
+        {
+        }
+
+        ~ScopedStage()
+        {
+            if (profiler.mMeasuring) {
+                profiler.mRecord.ticks[static_cast<size_t> (stage)] += static_cast<juce::uint32> (juce::Time::getHighResolutionTicks() - start);
+            }
+        }
+
+    private:
+        AudioThreadProfiler& profiler;
+        Stage stage;
+        juce::int64 start;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedStage)
+    };
+
+    //==============================================================================
+    // Message thread
+    Statistics getStatistics() const;
+    void reset();
+
+    // Writes a plain text report of the histograms and the recent overruns
+    bool dumpToFile (const juce::File& file) const;
+
+    static constexpr bool compiledIn { BASICSAMPLER_PROFILING != 0 };
+    static constexpr int fifoSize { 1024 };
+    static constexpr int maxRecentOverruns { 16 };
+
+private:
+    void timerCallback() override;
+    void collect (const BlockRecord& record);
+
+    std::atomic<bool> mEnabled { false };
+    std::atomic<double> mSampleRate { 44100.0 };
+
+    // Audio thread only
+    bool mMeasuring { false };
+    juce::int64 mBlockStart { 0 };
+    BlockRecord mRecord;
+
+    // Audio thread -> message thread
+    juce::AbstractFifo mFifo { fifoSize };
+    std::array<BlockRecord, fifoSize> mRecords;
+    std::atomic<juce::uint32> mNumDropped { 0 };
+
+    // Filled on the message thread, guarded so getStatistics() can be called from anywhere
+    juce::CriticalSection mStatisticsLock;
+    Statistics mStatistics;
+    juce::uint64 mVoiceSum { 0 };
+    juce::uint64 mMidiEventSum { 0 };
+    juce::uint32 mLastUnderruns { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioThreadProfiler)
+};
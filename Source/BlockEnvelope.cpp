@@ -0,0 +1,237 @@
+/*
+  ==============================================================================
+
+    BlockEnvelope.cpp
+    Created: 18 Oct 2026 2:08:19am
+    Author:  Adam Chung
+
+  ==============================================================================
+*/
+
+#include "BlockEnvelope.h"
+
+#if JUCE_INTEL
+ #include <immintrin.h>
+#endif
+
+#if JUCE_ARM && defined (__ARM_NEON)
+ #include <arm_neon.h>
+ #define BASICSAMPLER_HAS_NEON 1
+#else
+ #define BASICSAMPLER_HAS_NEON 0
+#endif
+
+namespace
+{
+    // A segment is over once it's this close to its target, relative to where it started
+    constexpr float segmentEndRatio { 0.001f };   // -60 dB
+
+    // dest[i] = (start + slope * (i + 1)) * gain
+    void fillLinear (float* dest, int numSamples, float start, float slope, float gain)
+    {
+        int i = 0;
+
+       #if JUCE_INTEL
+        const auto laneSteps = _mm_set_ps (4.0f, 3.0f, 2.0f, 1.0f);
+        const auto vStart = _mm_set1_ps (start);
+        const auto vSlope = _mm_set1_ps (slope);
+        const auto vGain = _mm_set1_ps (gain);
+
+        for (; i + 4 <= numSamples; i += 4) {
+            auto steps = _mm_add_ps (_mm_set1_ps (static_cast<float> (i)), laneSteps);
+            _mm_storeu_ps (dest + i, _mm_mul_ps (_mm_add_ps (vStart, _mm_mul_ps (vSlope, steps)), vGain));
+        }
+       #elif BASICSAMPLER_HAS_NEON
+        const float laneIndices[4] { 1.0f, 2.0f, 3.0f, 4.0f };
+        const auto laneSteps = vld1q_f32 (laneIndices);
+        const auto vStart = vdupq_n_f32 (start);
+
+        for (; i + 4 <= numSamples; i += 4) {
+            auto steps = vaddq_f32 (vdupq_n_f32 (static_cast<float> (i)), laneSteps);
+            vst1q_f32 (dest + i, vmulq_n_f32 (vmlaq_n_f32 (vStart, steps, slope), gain));
+        }
+       #endif
+
+        for (; i < numSamples; ++i) {
+            dest[i] = (start + slope * static_cast<float> (i + 1)) * gain;
+        }
+    }
+
+    // dest[i] = (target + distance * ratio^(i + 1)) * gain
+    void fillExponential (float* dest, int numSamples, float target, float distance, float ratio, float gain)
+    {
+        int i = 0;
+
+        // Each lane steps by ratio^4, the powers are only ever a few blocks' worth
+        // of multiplies away from an exact start so float is plenty
+        const auto r2 = ratio * ratio;
+        const auto r4 = r2 * r2;
+
+       #if JUCE_INTEL
+        auto powers = _mm_set_ps (distance * r4, distance * r2 * ratio, distance * r2, distance * ratio);
+        const auto vStep = _mm_set1_ps (r4);
+        const auto vTarget = _mm_set1_ps (target);
+        const auto vGain = _mm_set1_ps (gain);
+
+        for (; i + 4 <= numSamples; i += 4) {
+            _mm_storeu_ps (dest + i, _mm_mul_ps (_mm_add_ps (vTarget, powers), vGain));
+            powers = _mm_mul_ps (powers, vStep);
+        }
+       #elif BASICSAMPLER_HAS_NEON
+        const float lanePowers[4] { distance * ratio, distance * r2, distance * r2 * ratio, distance * r4 };
+        auto powers = vld1q_f32 (lanePowers);
+        const auto vTarget = vdupq_n_f32 (target);
+
+        for (; i + 4 <= numSamples; i += 4) {
+            vst1q_f32 (dest + i, vmulq_n_f32 (vaddq_f32 (vTarget, powers), gain));
+            powers = vmulq_n_f32 (powers, r4);
+        }
+       #endif
+
+        auto value = distance * std::pow (ratio, static_cast<float> (i));
+
+        for (; i < numSamples; ++i) {
+            value *= ratio;
+            dest[i] = (target + value) * gain;
+        }
+    }
+}
+
+//==============================================================================
+BlockEnvelope::BlockEnvelope()
+{
+}
+
+BlockEnvelope::~BlockEnvelope()
+{
+}
+
+void BlockEnvelope::noteOn (const juce::ADSR::Parameters& parameters)
+{
+    mParameters = parameters;
+    startAttack();
+}
+
+void BlockEnvelope::noteOff()
+{
+    if (mStage != Stage::idle && mStage != Stage::release) {
+        startRelease();
+    }
+}
+
+void BlockEnvelope::reset()
+{
+    mStage = Stage::idle;
+    mLevel = 0.0f;
+    mSamplesLeft = 0;
+}
+
+//==============================================================================
+void BlockEnvelope::startAttack()
+{
+    auto attackSamples = mParameters.attack * mSampleRate;
+
+    if (attackSamples < 1.0 || mLevel >= 1.0f) {
+        mLevel = 1.0f;
+        startDecay();
+        return;
+    }
+
+    // A retrigger ramps up from the level the note was at, at the same rate
+    mStage = Stage::attack;
+    mSamplesLeft = juce::jmax (1, juce::roundToInt ((1.0f - mLevel) * attackSamples));
+    mSlope = (1.0f - mLevel) / static_cast<float> (mSamplesLeft);
+}
+
+void BlockEnvelope::startDecay()
+{
+    if (mParameters.sustain >= 1.0f) {
+        startSustain();
+        return;
+    }
+
+    startExponential (Stage::decay, juce::jmax (0.0f, mParameters.sustain), mParameters.decay);
+}
+
+void BlockEnvelope::startSustain()
+{
+    mStage = Stage::sustain;
+    mLevel = juce::jlimit (0.0f, 1.0f, mParameters.sustain);
+}
+
+void BlockEnvelope::startRelease()
+{
+    startExponential (Stage::release, 0.0f, mParameters.release);
+}
+
+void BlockEnvelope::startExponential (Stage stage, float target, float seconds)
+{
+    auto numSamples = static_cast<double> (seconds) * mSampleRate;
+
+    // Too short to hear as a curve, the segment is over straight away
+    if (numSamples < 1.0) {
+        mLevel = target;
+
+        if (stage == Stage::decay) {
+            startSustain();
+        } else {
+            reset();
+        }
+
+        return;
+    }
+
+    mStage = stage;
+    mTarget = target;
+    mSamplesLeft = juce::roundToInt (numSamples);
+    mRatio = static_cast<float> (std::pow (static_cast<double> (segmentEndRatio), 1.0 / numSamples));
+}
+
+//==============================================================================
+int BlockEnvelope::render (float* gains, int numSamples, float gain)
+{
+    int done = 0;
+
+    while (done < numSamples && mStage != Stage::idle) {
+        // The sustain runs until the note's let go, every other segment to its end
+        auto numThisSegment = mStage == Stage::sustain ? numSamples - done
+                                                       : juce::jmin (numSamples - done, mSamplesLeft);
+
+        switch (mStage) {
+            case Stage::attack:
+                fillLinear (gains + done, numThisSegment, mLevel, mSlope, gain);
+                mLevel += mSlope * static_cast<float> (numThisSegment);
+                break;
+
+            case Stage::decay:
+            case Stage::release:
+                fillExponential (gains + done, numThisSegment, mTarget, mLevel - mTarget, mRatio, gain);
+                mLevel = mTarget + (mLevel - mTarget) * std::pow (mRatio, static_cast<float> (numThisSegment));
+                break;
+
+            case Stage::sustain:
+                juce::FloatVectorOperations::fill (gains + done, mLevel * gain, numThisSegment);
+                break;
+
+            case Stage::idle:
+                break;
+        }
+
+        done += numThisSegment;
+
+        if (mStage == Stage::sustain || (mSamplesLeft -= numThisSegment) > 0) {
+            continue;
+        }
+
+        // Segment boundaries land on exact samples, and each segment ends on its target
+        switch (mStage) {
+            case Stage::attack:  mLevel = 1.0f; startDecay(); break;
+            case Stage::decay:   startSustain(); break;
+            case Stage::release: reset(); break;
+            case Stage::sustain:
+            case Stage::idle:    break;
+        }
+    }
+
+    return done;
+}
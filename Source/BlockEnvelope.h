@@ -0,0 +1,70 @@
+/*
+  ==============================================================================
+
+    BlockEnvelope.h
+    Created: 18 Oct 2026 2:08:19am
+    Author:  Adam Chung
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/*
+    An ADSR envelope that renders whole blocks of gain at a time.
+
+    The attack is a linear ramp, decay and release are exponential, each
+    segment reaching -60 dB of the distance to its target in the segment's
+    time and then snapping to it. Every segment has a closed form, so a block
+    is worked out segment by segment rather than sample by sample: where the
+    segment boundaries fall is resolved once, and the gains in between are
+    written four at a time with SSE2 or NEON.
+
+    Every note takes its own copy of the parameters when it starts, so turning
+    the knobs only changes notes played afterwards.
+*/
+class BlockEnvelope
+{
+public:
+    BlockEnvelope();
+    ~BlockEnvelope();
+
+    void setSampleRate (double sampleRate) { mSampleRate = sampleRate; }
+
+    // Starts the attack from wherever the envelope is, with a snapshot of parameters
+    void noteOn (const juce::ADSR::Parameters& parameters);
+    void noteOff();
+    void reset();
+
+    bool isActive() const { return mStage != Stage::idle; }
+    float getLevel() const { return mLevel; }
+
+    // Writes the next numSamples of the envelope, times gain, into gains. Returns
+    // how many were written: fewer than numSamples if the envelope ended.
+    int render (float* gains, int numSamples, float gain);
+
+private:
+    enum class Stage { idle, attack, decay, sustain, release };
+
+    void startAttack();
+    void startDecay();
+    void startSustain();
+    void startRelease();
+    void startExponential (Stage stage, float target, float seconds);
+
+    juce::ADSR::Parameters mParameters;
+    double mSampleRate { 44100.0 };
+
+    Stage mStage { Stage::idle };
+    float mLevel { 0.0f };
+    int mSamplesLeft { 0 };      // in the current segment, sustain has no end
+
+    float mSlope { 0.0f };       // attack, per sample
+    float mTarget { 0.0f };      // decay and release
+    float mRatio { 1.0f };       // how much of the distance to the target is left after each sample
+
+    JUCE_LEAK_DETECTOR (BlockEnvelope)
+};
@@ -0,0 +1,354 @@
+/*
+  ==============================================================================
+
+    CompactSampleBuffer.cpp
+    Created: 17 Oct 2026 11:38:52pm
+    Author:  Adam Chung
+
+  ==============================================================================
+*/
+
+#include "CompactSampleBuffer.h"
+#include <cstring>
+
+namespace
+{
+    constexpr float int16Scale = 1.0f / 32768.0f;
+    constexpr int maxPredictorOrder = 2;
+
+    // Matches the reader's own conversion, so 16-bit files round trip exactly
+    juce::int16 toInt16 (float sample)
+    {
+        return static_cast<juce::int16> (juce::jlimit (-32768, 32767, juce::roundToInt (sample * 32768.0f)));
+    }
+
+    int predict (int order, int previous, int beforePrevious)
+    {
+        switch (order) {
+            case 1:  return previous;
+            case 2:  return 2 * previous - beforePrevious;
+            default: return 0;
+        }
+    }
+
+    juce::uint32 zigZag (int residual)
+    {
+        return (static_cast<juce::uint32> (residual) << 1) ^ static_cast<juce::uint32> (residual >> 31);
+    }
+
+    int bitsNeeded (juce::uint32 value)
+    {
+        int bits = 0;
+
+        while (value != 0) {
+            ++bits;
+            value >>= 1;
+        }
+
+        return bits;
+    }
+
+    std::atomic<juce::uint32> nextBufferId { 1 };
+}
+
+//==============================================================================
+juce::StringArray CompactSampleBuffer::getFormatNames()
+{
+    return { "Float", "16-bit", "Compressed" };
+}
+
+double CompactSampleBuffer::getTypicalBytesPerFrame (Format format)
+{
+    switch (format) {
+        case Format::int16:      return 2 * sizeof (juce::int16);
+        case Format::compressed: return 2.5;
+        case Format::float32:
+        default:                 return 2 * sizeof (float);
+    }
+}
+
+CompactSampleBuffer::CompactSampleBuffer()
+{
+}
+
+CompactSampleBuffer::~CompactSampleBuffer()
+{
+}
+
+void CompactSampleBuffer::store (const juce::AudioBuffer<float>& source, int numFrames, Format format)
+{
+    jassert (source.getNumChannels() == 2 && numFrames <= source.getNumSamples());
+
+    mFormat = format;
+    mNumFrames = numFrames;
+    mId = nextBufferId++;
+    mDecodeNanosPerFrame = 0.0;
+
+    mFloat.setSize (0, 0);
+    mCompressed.clear();
+    mBlockOffsets.clear();
+
+    for (auto& channel : mInt16) {
+        channel.clear();
+    }
+
+    if (format == Format::float32) {
+        mFloat.setSize (2, numFrames);
+
+        for (int ch = 0; ch < 2; ++ch) {
+            mFloat.copyFrom (ch, 0, source, ch, 0, numFrames);
+        }
+
+        return;
+    }
+
+    if (format == Format::compressed) {
+        compress (source);
+        mDecodeNanosPerFrame = measureDecodeNanosPerFrame();
+
+        if (mDecodeNanosPerFrame <= maxDecodeNanosPerFrame) {
+            return;
+        }
+
+        // Too slow to be worth the memory it saves on this machine
+        mFormat = Format::int16;
+        mDecodeNanosPerFrame = 0.0;
+        mCompressed = {};
+        mBlockOffsets = {};
+    }
+
+    for (int ch = 0; ch < 2; ++ch) {
+        auto* samples = source.getReadPointer (ch);
+        mInt16[ch].resize (static_cast<size_t> (numFrames));
+
+        for (int i = 0; i < numFrames; ++i) {
+            mInt16[ch][static_cast<size_t> (i)] = toInt16 (samples[i]);
+        }
+    }
+}
+
+size_t CompactSampleBuffer::getSizeInBytes() const
+{
+    return static_cast<size_t> (mFloat.getNumChannels() * mFloat.getNumSamples()) * sizeof (float)
+         + (mInt16[0].size() + mInt16[1].size()) * sizeof (juce::int16)
+         + mCompressed.size()
+         + mBlockOffsets.size() * sizeof (juce::uint32);
+}
+
+//==============================================================================
+void CompactSampleBuffer::compress (const juce::AudioBuffer<float>& source)
+{
+    // Every block is coded on its own, channel after channel:
+    //   predictor order (1 byte), residual width in bits (1 byte),
+    //   order warm-up samples (2 bytes each, little endian),
+    //   the zig-zagged residuals of the remaining frames, packed LSB first.
+    std::vector<int> samples (blockFrames);
+    std::array<std::vector<juce::uint32>, maxPredictorOrder + 1> residuals;
+
+    for (auto& r : residuals) {
+        r.resize (blockFrames);
+    }
+
+    for (int start = 0; start < mNumFrames; start += blockFrames) {
+        auto numInBlock = juce::jmin (blockFrames, mNumFrames - start);
+        mBlockOffsets.push_back (static_cast<juce::uint32> (mCompressed.size()));
+
+        for (int ch = 0; ch < 2; ++ch) {
+            auto* input = source.getReadPointer (ch, start);
+
+            for (int i = 0; i < numInBlock; ++i) {
+                samples[static_cast<size_t> (i)] = toInt16 (input[i]);
+            }
+
+            // FLAC's fixed predictors, whichever packs smallest wins
+            int bestOrder = 0;
+            int bestWidth = 0;
+            auto bestBits = std::numeric_limits<juce::int64>::max();
+
+            for (int order = 0; order <= juce::jmin (maxPredictorOrder, numInBlock); ++order) {
+                juce::uint32 largest = 0;
+
+                for (int i = order; i < numInBlock; ++i) {
+                    auto previous = i > 0 ? samples[static_cast<size_t> (i - 1)] : 0;
+                    auto beforePrevious = i > 1 ? samples[static_cast<size_t> (i - 2)] : 0;
+                    auto value = zigZag (samples[static_cast<size_t> (i)] - predict (order, previous, beforePrevious));
+                    residuals[static_cast<size_t> (order)][static_cast<size_t> (i)] = value;
+                    largest = juce::jmax (largest, value);
+                }
+
+                auto width = bitsNeeded (largest);
+                auto bits = static_cast<juce::int64> (order) * 16 + static_cast<juce::int64> (numInBlock - order) * width;
+
+                if (bits < bestBits) {
+                    bestBits = bits;
+                    bestOrder = order;
+                    bestWidth = width;
+                }
+            }
+
+            mCompressed.push_back (static_cast<juce::uint8> (bestOrder));
+            mCompressed.push_back (static_cast<juce::uint8> (bestWidth));
+
+            for (int i = 0; i < bestOrder; ++i) {
+                auto value = static_cast<juce::uint16> (samples[static_cast<size_t> (i)]);
+                mCompressed.push_back (static_cast<juce::uint8> (value & 0xff));
+                mCompressed.push_back (static_cast<juce::uint8> (value >> 8));
+            }
+
+            juce::uint64 accumulator = 0;
+            int numBits = 0;
+
+            for (int i = bestOrder; i < numInBlock; ++i) {
+                accumulator |= static_cast<juce::uint64> (residuals[static_cast<size_t> (bestOrder)][static_cast<size_t> (i)]) << numBits;
+                numBits += bestWidth;
+
+                while (numBits >= 8) {
+                    mCompressed.push_back (static_cast<juce::uint8> (accumulator & 0xff));
+                    accumulator >>= 8;
+                    numBits -= 8;
+                }
+            }
+
+            if (numBits > 0) {
+                mCompressed.push_back (static_cast<juce::uint8> (accumulator & 0xff));
+            }
+        }
+    }
+
+    mCompressed.resize (mCompressed.size() + sizeof (juce::uint64));
+    mCompressed.shrink_to_fit();
+    mBlockOffsets.shrink_to_fit();
+}
+
+void CompactSampleBuffer::decodeBlock (int block, DecodedBlock& dest) const
+{
+    auto* data = mCompressed.data() + mBlockOffsets[static_cast<size_t> (block)];
+    auto numInBlock = juce::jmin (blockFrames, mNumFrames - block * blockFrames);
+
+    for (int ch = 0; ch < 2; ++ch) {
+        auto* output = dest[static_cast<size_t> (ch)].data();
+        int order = *data++;
+        int width = *data++;
+        int previous = 0;
+        int beforePrevious = 0;
+
+        for (int i = 0; i < order; ++i) {
+            auto value = static_cast<juce::int16> (data[0] | (data[1] << 8));
+            data += 2;
+
+            beforePrevious = previous;
+            previous = value;
+            output[i] = static_cast<float> (value) * int16Scale;
+        }
+
+        // Each residual is pulled out of one unaligned little-endian 64-bit load,
+        // the data is padded so the last load never reads past its end
+        auto mask = width > 0 ? (juce::uint64 { 1 } << width) - 1 : 0;
+        size_t bitPosition = 0;
+
+        for (int i = order; i < numInBlock; ++i) {
+            juce::uint64 word;
+            std::memcpy (&word, data + (bitPosition >> 3), sizeof (word));
+            auto value = static_cast<juce::uint32> ((word >> (bitPosition & 7)) & mask);
+            bitPosition += static_cast<size_t> (width);
+
+            auto residual = static_cast<int> (value >> 1) ^ -static_cast<int> (value & 1);
+            auto sample = predict (order, previous, beforePrevious) + residual;
+
+            beforePrevious = previous;
+            previous = sample;
+            output[i] = static_cast<float> (sample) * int16Scale;
+        }
+
+        data += (bitPosition + 7) >> 3;
+    }
+}
+
+double CompactSampleBuffer::measureDecodeNanosPerFrame() const
+{
+    // A few blocks are plenty to tell how fast this material decodes
+    constexpr int maxBlocksToMeasure = 32;
+    auto numBlocks = juce::jmin (maxBlocksToMeasure, static_cast<int> (mBlockOffsets.size()));
+
+    if (numBlocks == 0) {
+        return 0.0;
+    }
+
+    auto decoded = std::make_unique<DecodedBlock>();
+    auto seconds = std::numeric_limits<double>::max();
+
+    // Best of two, the first pass pays for the cold cache
+    for (int pass = 0; pass < 2; ++pass) {
+        auto start = juce::Time::getHighResolutionTicks();
+
+        for (int block = 0; block < numBlocks; ++block) {
+            decodeBlock (block, *decoded);
+        }
+
+        seconds = juce::jmin (seconds, juce::Time::highResolutionTicksToSeconds (juce::Time::getHighResolutionTicks() - start));
+    }
+
+    auto numFrames = juce::jmin (mNumFrames, numBlocks * blockFrames);
+    return seconds * 1.0e9 / numFrames;
+}
+
+//==============================================================================
+CompactSampleBuffer::Cursor::Cursor()
+{
+}
+
+void CompactSampleBuffer::Cursor::read (const CompactSampleBuffer& source, juce::AudioBuffer<float>& dest,
+                                        int destStartFrame, int numFrames, int sourceStartFrame)
+{
+    jassert (sourceStartFrame >= 0 && sourceStartFrame + numFrames <= source.mNumFrames);
+    auto numChannels = juce::jmin (2, dest.getNumChannels());
+
+    switch (source.mFormat) {
+        case Format::float32:
+            for (int ch = 0; ch < numChannels; ++ch) {
+                dest.copyFrom (ch, destStartFrame, source.mFloat, ch, sourceStartFrame, numFrames);
+            }
+            break;
+
+        case Format::int16:
+            for (int ch = 0; ch < numChannels; ++ch) {
+                auto* input = source.mInt16[static_cast<size_t> (ch)].data() + sourceStartFrame;
+                auto* output = dest.getWritePointer (ch, destStartFrame);
+
+                for (int i = 0; i < numFrames; ++i) {
+                    output[i] = static_cast<float> (input[i]) * int16Scale;
+                }
+            }
+            break;
+
+        case Format::compressed:
+            if (source.mId != mSourceId) {
+                mSourceId = source.mId;
+                mBlocks = { -1, -1 };
+            }
+
+            // Each block a voice moves into is decoded once, so the decode cost per
+            // frame stays at what store() measured however the reads are split up
+            while (numFrames > 0) {
+                auto block = sourceStartFrame / blockFrames;
+                auto slot = static_cast<size_t> (block & 1);
+
+                if (mBlocks[slot] != block) {
+                    source.decodeBlock (block, mDecoded[slot]);
+                    mBlocks[slot] = block;
+                }
+
+                auto offset = sourceStartFrame - block * blockFrames;
+                auto numThisBlock = juce::jmin (numFrames, blockFrames - offset);
+
+                for (int ch = 0; ch < numChannels; ++ch) {
+                    dest.copyFrom (ch, destStartFrame, mDecoded[slot][static_cast<size_t> (ch)].data() + offset, numThisBlock);
+                }
+
+                destStartFrame += numThisBlock;
+                sourceStartFrame += numThisBlock;
+                numFrames -= numThisBlock;
+            }
+            break;
+    }
+}
@@ -0,0 +1,105 @@
+/*
+  ==============================================================================
+
+    CompactSampleBuffer.h
+    Created: 17 Oct 2026 11:38:52pm
+    Author:  Adam Chung
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/*
+    Stereo sample frames held in RAM in one of three formats:
+
+      - float32: as decoded, 8 bytes a frame
+      - int16: 4 bytes a frame, lossless for 16-bit source material
+      - compressed: the int16 frames split into blocks of blockFrames, each
+        channel coded with the best of FLAC's fixed order 0-2 predictors and
+        its residuals bit-packed. A seek index of block offsets keeps random
+        access cheap. Typically 2-3 bytes a frame.
+
+    Readers go through a Cursor, which keeps the last block it decoded, so a
+    voice moving forward through a compressed buffer decodes each block once.
+*/
+class CompactSampleBuffer
+{
+public:
+    enum class Format
+    {
+        float32,
+        int16,
+        compressed
+    };
+
+    static juce::StringArray getFormatNames();
+
+    static constexpr int blockFrames { 1024 };
+
+    // The most a voice may spend decoding a frame, ~2.5% of a core for 64
+    // voices at 48kHz. Compressed data that decodes slower is kept as int16.
+    static constexpr double maxDecodeNanosPerFrame { 8.0 };
+
+    // Rough size of a frame in each format, for memory budgets
+    static double getTypicalBytesPerFrame (Format format);
+
+    CompactSampleBuffer();
+    ~CompactSampleBuffer();
+
+    // Takes the first numFrames of a stereo source. int16 and compressed
+    // storage quantise to 16 bits, so are only lossless for 16-bit sources.
+    void store (const juce::AudioBuffer<float>& source, int numFrames, Format format);
+
+    Format getFormat() const { return mFormat; }
+    int getNumFrames() const { return mNumFrames; }
+    size_t getSizeInBytes() const;
+
+    // Measured once when a compressed buffer is stored, zero for the others
+    double getDecodeNanosPerFrame() const { return mDecodeNanosPerFrame; }
+
+    using DecodedBlock = std::array<std::array<float, blockFrames>, 2>;
+
+    //==============================================================================
+    class Cursor
+    {
+    public:
+        Cursor();
+
+        // Any thread, without allocating. Fills dest with frames converted to float.
+        void read (const CompactSampleBuffer& source, juce::AudioBuffer<float>& dest,
+                   int destStartFrame, int numFrames, int sourceStartFrame);
+
+    private:
+        // Buffers are told apart by id, a new one may reuse a freed one's address
+        juce::uint32 mSourceId { 0 };
+
+        // Two blocks, so reading back across a block boundary, as interpolation
+        // padding does, never decodes the same block twice in a row
+        std::array<int, 2> mBlocks { -1, -1 };
+        std::array<DecodedBlock, 2> mDecoded;
+
+        JUCE_DECLARE_NON_COPYABLE (Cursor)
+    };
+
+private:
+    void compress (const juce::AudioBuffer<float>& source);
+    void decodeBlock (int block, DecodedBlock& dest) const;
+    double measureDecodeNanosPerFrame() const;
+
+    Format mFormat { Format::float32 };
+    int mNumFrames { 0 };
+
+    juce::AudioBuffer<float> mFloat;
+    std::array<std::vector<juce::int16>, 2> mInt16;
+    std::vector<juce::uint8> mCompressed;
+    std::vector<juce::uint32> mBlockOffsets;
+
+    double mDecodeNanosPerFrame { 0.0 };
+    juce::uint32 mId { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CompactSampleBuffer)
+};
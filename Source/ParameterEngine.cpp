@@ -0,0 +1,130 @@
+/*
+  ==============================================================================
+
+    ParameterEngine.cpp
+    Created: 17 Oct 2026 7:12:36pm
+    Author:  Adam Chung
+
+  ==============================================================================
+*/
+
+#include "ParameterEngine.h"
+
+//==============================================================================
+ParameterEngine::ParameterEngine (juce::AudioProcessorValueTreeState& state)
+    : mState (state)
+{
+    for (int i = 0; i < numParameters; ++i) {
+        auto id = getParameterId (static_cast<Id> (i));
+
+        mValues[static_cast<size_t> (i)] = mState.getRawParameterValue (id);
+        jassert (mValues[static_cast<size_t> (i)] != nullptr);
+
+        mState.addParameterListener (id, this);
+    }
+
+    markAllChanged();
+}
+
+ParameterEngine::~ParameterEngine()
+{
+    for (int i = 0; i < numParameters; ++i) {
+        mState.removeParameterListener (getParameterId (static_cast<Id> (i)), this);
+    }
+}
+
+const char* ParameterEngine::getParameterId (Id id)
+{
+    switch (id) {
+        case attack:               return "ATTACK";
+        case decay:                return "DECAY";
+        case sustain:              return "SUSTAIN";
+        case release:              return "RELEASE";
+        case interpolation:        return "INTERPOLATION";
+        case polyphony:            return "POLYPHONY";
+        case renderThreads:        return "RENDER_THREADS";
+        case storage:              return "STORAGE";
+        case swapCrossfade:        return "SWAP_CROSSFADE";
+        case trim:                 return "TRIM";
+        case normalisation:        return "NORMALISE";
+        case autoLoop:             return "AUTO_LOOP";
+        case playback:             return "PLAYBACK";
+        case stretchSpeed:         return "STRETCH_SPEED";
+        case grains:               return "GRAINS";
+        case filterType:           return "FILTER_TYPE";
+        case filterCutoff:         return "FILTER_CUTOFF";
+        case filterResonance:      return "FILTER_RESONANCE";
+        case filterEnvelopeAmount: return "FILTER_ENV_AMOUNT";
+        case filterAttack:         return "FILTER_ATTACK";
+        case filterDecay:          return "FILTER_DECAY";
+        case filterSustain:        return "FILTER_SUSTAIN";
+        case filterRelease:        return "FILTER_RELEASE";
+        case numParameters: break;
+    }
+
+    jassertfalse;
+    return "";
+}
+
+juce::ADSR::Parameters ParameterEngine::getEnvelopeParameters() const
+{
+    juce::ADSR::Parameters params;
+    params.attack = get (attack);
+    params.decay = get (decay);
+    params.sustain = get (sustain);
+    params.release = get (release);
+    return params;
+}
+
+SamplePreprocessor::Settings ParameterEngine::getPreprocessingSettings() const
+{
+    SamplePreprocessor::Settings settings;
+    settings.trim = get (trim) >= 0.5f;
+    settings.normalisation = static_cast<SamplePreprocessor::Normalisation> (static_cast<int> (get (normalisation)));
+    settings.findLoop = get (autoLoop) >= 0.5f;
+    return settings;
+}
+
+TimeStretcher::Settings ParameterEngine::getStretchSettings() const
+{
+    TimeStretcher::Settings settings;
+    settings.enabled = static_cast<int> (get (playback)) == 1;   // see TimeStretcher::getPlaybackNames()
+    settings.speed = get (stretchSpeed);
+    settings.numGrains = static_cast<int> (get (grains));
+    return settings;
+}
+
+VoiceFilter::Parameters ParameterEngine::getFilterParameters() const
+{
+    VoiceFilter::Parameters params;
+    params.type = static_cast<VoiceFilter::Type> (static_cast<int> (get (filterType)));
+    params.cutoff = get (filterCutoff);
+    params.resonance = get (filterResonance);
+    params.envelopeAmount = get (filterEnvelopeAmount);
+    params.envelope.attack = get (filterAttack);
+    params.envelope.decay = get (filterDecay);
+    params.envelope.sustain = get (filterSustain);
+    params.envelope.release = get (filterRelease);
+    return params;
+}
+
+juce::uint32 ParameterEngine::takeChanges()
+{
+    // The common case, nothing to do and no read-modify-write either
+    if (mChanges.load (std::memory_order_relaxed) == 0) {
+        return 0;
+    }
+
+    return mChanges.exchange (0, std::memory_order_acquire);
+}
+
+void ParameterEngine::parameterChanged (const juce::String& parameterID, float /*newValue*/)
+{
+    // Can arrive on any thread, the audio thread included, so only flag it here
+    for (int i = 0; i < numParameters; ++i) {
+        if (parameterID == getParameterId (static_cast<Id> (i))) {
+            mChanges.fetch_or (changed (static_cast<Id> (i)), std::memory_order_release);
+            return;
+        }
+    }
+}
@@ -0,0 +1,91 @@
+/*
+  ==============================================================================
+
+    ParameterEngine.h
+    Created: 17 Oct 2026 7:12:36pm
+    Author:  Adam Chung
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "SamplePreprocessor.h"
+#include "TimeStretcher.h"
+#include "VoiceFilter.h"
+
+//==============================================================================
+/*
+    The plugin's parameters as seen from the audio thread.
+
+    Every parameter's value pointer is looked up once, up front. Changes are
+    flagged in a single atomic bit mask, which any thread can set without
+    locking. Several changes to one parameter collapse into one flag, and the
+    audio thread collects all of them with one exchange. When nothing has
+    changed, a block costs one relaxed load.
+*/
+class ParameterEngine  : private juce::AudioProcessorValueTreeState::Listener
+{
+public:
+    enum Id
+    {
+        attack,
+        decay,
+        sustain,
+        release,
+        interpolation,
+        polyphony,
+        renderThreads,
+        storage,
+        swapCrossfade,
+        trim,
+        normalisation,
+        autoLoop,
+        playback,
+        stretchSpeed,
+        grains,
+        filterType,
+        filterCutoff,
+        filterResonance,
+        filterEnvelopeAmount,
+        filterAttack,
+        filterDecay,
+        filterSustain,
+        filterRelease,
+        numParameters
+    };
+
+    explicit ParameterEngine (juce::AudioProcessorValueTreeState& state);
+    ~ParameterEngine() override;
+
+    static const char* getParameterId (Id id);
+
+    float get (Id id) const { return mValues[static_cast<size_t> (id)]->load (std::memory_order_relaxed); }
+    juce::ADSR::Parameters getEnvelopeParameters() const;
+    SamplePreprocessor::Settings getPreprocessingSettings() const;
+    TimeStretcher::Settings getStretchSettings() const;
+    VoiceFilter::Parameters getFilterParameters() const;
+
+    // Audio thread. Returns the bits, as in changed (id), of everything that
+    // changed since the last call, and clears them.
+    juce::uint32 takeChanges();
+
+    // Flags everything, e.g. so prepareToPlay pushes the full state again
+    void markAllChanged() { mChanges.fetch_or ((1u << numParameters) - 1u); }
+
+    static constexpr juce::uint32 changed (Id id) { return 1u << id; }
+    static constexpr juce::uint32 envelopeChanges { (1u << attack) | (1u << decay) | (1u << sustain) | (1u << release) };
+    static constexpr juce::uint32 stretchChanges { (1u << playback) | (1u << stretchSpeed) | (1u << grains) };
+    static constexpr juce::uint32 filterChanges { (1u << filterType) | (1u << filterCutoff) | (1u << filterResonance) | (1u << filterEnvelopeAmount)
+                                                | (1u << filterAttack) | (1u << filterDecay) | (1u << filterSustain) | (1u << filterRelease) };
+
+private:
+    void parameterChanged (const juce::String& parameterID, float newValue) override;
+
+    juce::AudioProcessorValueTreeState& mState;
+    std::array<std::atomic<float>*, numParameters> mValues;
+    std::atomic<juce::uint32> mChanges { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ParameterEngine)
+};
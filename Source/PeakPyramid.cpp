@@ -0,0 +1,163 @@
+/*
+  ==============================================================================
+
+    PeakPyramid.cpp
+    Created: 17 Oct 2026 1:47:15pm
+    Author:  Adam Chung
+
+  ==============================================================================
+*/
+
+#include "PeakPyramid.h"
+
+namespace
+{
+    PeakPyramid::Peak mergePeaks (const PeakPyramid::Peak& a, const PeakPyramid::Peak& b)
+    {
+        return { juce::jmin (a.min, b.min),
+                 juce::jmax (a.max, b.max),
+                 std::sqrt ((a.rms * a.rms + b.rms * b.rms) * 0.5f) };
+    }
+}
+
+//==============================================================================
+PeakPyramid::PeakPyramid()
+{
+}
+
+PeakPyramid::~PeakPyramid()
+{
+}
+
+void PeakPyramid::clear()
+{
+    mLevels.clear();
+    mNumSamples = 0;
+}
+
+void PeakPyramid::build (const juce::AudioBuffer<float>& source)
+{
+    clear();
+
+    if (source.getNumSamples() == 0 || source.getNumChannels() == 0) {
+        return;
+    }
+
+    std::vector<Peak> base;
+    appendBasePeaks (source, source.getNumSamples(), base);
+
+    mNumSamples = source.getNumSamples();
+    buildLevels (std::move (base));
+}
+
+void PeakPyramid::build (juce::AudioFormatReader& reader)
+{
+    clear();
+
+    auto numChannels = static_cast<int> (reader.numChannels);
+
+    if (reader.lengthInSamples <= 0 || numChannels == 0) {
+        return;
+    }
+
+    std::vector<Peak> base;
+    base.reserve (static_cast<size_t> ((reader.lengthInSamples + baseSamplesPerPeak - 1) / baseSamplesPerPeak));
+
+    // Chunks are whole numbers of peaks, so only the very last peak can be short
+    juce::AudioBuffer<float> chunk (numChannels, readChunkSamples);
+
+    for (juce::int64 position = 0; position < reader.lengthInSamples; position += readChunkSamples) {
+        auto numThisTime = static_cast<int> (juce::jmin<juce::int64> (readChunkSamples, reader.lengthInSamples - position));
+        reader.read (&chunk, 0, numThisTime, position, true, numChannels > 1);
+        appendBasePeaks (chunk, numThisTime, base);
+    }
+
+    mNumSamples = reader.lengthInSamples;
+    buildLevels (std::move (base));
+}
+
+void PeakPyramid::appendBasePeaks (const juce::AudioBuffer<float>& source, int numSamples, std::vector<Peak>& dest)
+{
+    auto numChannels = source.getNumChannels();
+    auto channelScale = 1.0f / static_cast<float> (numChannels);
+
+    for (int start = 0; start < numSamples; start += baseSamplesPerPeak) {
+        auto num = juce::jmin (baseSamplesPerPeak, numSamples - start);
+        auto lo = std::numeric_limits<float>::max();
+        auto hi = std::numeric_limits<float>::lowest();
+        auto sumSquares = 0.0f;
+
+        for (int i = start; i < start + num; ++i) {
+            auto value = 0.0f;
+
+            for (int ch = 0; ch < numChannels; ++ch) {
+                value += source.getSample (ch, i);
+            }
+
+            value *= channelScale;
+            lo = juce::jmin (lo, value);
+            hi = juce::jmax (hi, value);
+            sumSquares += value * value;
+        }
+
+        dest.push_back ({ lo, hi, std::sqrt (sumSquares / static_cast<float> (num)) });
+    }
+}
+
+void PeakPyramid::buildLevels (std::vector<Peak> base)
+{
+    mLevels.push_back (std::move (base));
+
+    // Every level above merges pairs from the one below, down to a handful of peaks
+    while (mLevels.back().size() > 64) {
+        const auto& below = mLevels.back();
+        std::vector<Peak> level ((below.size() + 1) / 2);
+
+        for (size_t p = 0; p < level.size(); ++p) {
+            auto i = p * 2;
+            level[p] = i + 1 < below.size() ? mergePeaks (below[i], below[i + 1]) : below[i];
+        }
+
+        mLevels.push_back (std::move (level));
+    }
+}
+
+void PeakPyramid::getPeaks (juce::int64 startSample, juce::int64 numSamples, Peak* dest, int numPixels) const
+{
+    if (isEmpty() || numSamples <= 0 || numPixels <= 0) {
+        std::fill (dest, dest + juce::jmax (0, numPixels), Peak {});
+        return;
+    }
+
+    auto samplesPerPixel = static_cast<double> (numSamples) / numPixels;
+
+    int level = 0;
+    while (level + 1 < getNumLevels() && getSamplesPerPeak (level + 1) <= samplesPerPixel) {
+        ++level;
+    }
+
+    const auto& peaks = mLevels[static_cast<size_t> (level)];
+    const auto samplesPerPeak = static_cast<double> (getSamplesPerPeak (level));
+    const auto lastPeak = static_cast<juce::int64> (peaks.size()) - 1;
+
+    for (int x = 0; x < numPixels; ++x) {
+        auto first = static_cast<juce::int64> ((startSample + x * samplesPerPixel) / samplesPerPeak);
+        auto last = static_cast<juce::int64> ((startSample + (x + 1) * samplesPerPixel) / samplesPerPeak);
+
+        first = juce::jlimit<juce::int64> (0, lastPeak, first);
+        last = juce::jlimit<juce::int64> (first, lastPeak, last - 1);
+
+        auto peak = peaks[static_cast<size_t> (first)];
+        auto sumSquares = peak.rms * peak.rms;
+
+        for (auto p = first + 1; p <= last; ++p) {
+            const auto& next = peaks[static_cast<size_t> (p)];
+            peak.min = juce::jmin (peak.min, next.min);
+            peak.max = juce::jmax (peak.max, next.max);
+            sumSquares += next.rms * next.rms;
+        }
+
+        peak.rms = std::sqrt (sumSquares / static_cast<float> (last - first + 1));
+        dest[x] = peak;
+    }
+}
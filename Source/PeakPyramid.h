@@ -0,0 +1,67 @@
+/*
+  ==============================================================================
+
+    PeakPyramid.h
+    Created: 17 Oct 2026 1:47:15pm
+    Author:  Adam Chung
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/*
+    Min/max/RMS summaries of a sample at power-of-two resolutions, so drawing
+    it costs the same whatever the file length.
+
+    Level 0 summarises baseSamplesPerPeak samples per peak, each level above
+    halves the resolution of the one below.
+*/
+class PeakPyramid
+{
+public:
+    struct Peak
+    {
+        float min { 0.0f };
+        float max { 0.0f };
+        float rms { 0.0f };
+    };
+
+    PeakPyramid();
+    ~PeakPyramid();
+
+    PeakPyramid (PeakPyramid&&) = default;
+    PeakPyramid& operator= (PeakPyramid&&) = default;
+
+    // Mixes every channel of source down, meant to be called off the message thread
+    void build (const juce::AudioBuffer<float>& source);
+
+    // The same for a whole file, read readChunkSamples at a time so only one
+    // chunk of it is ever in memory
+    void build (juce::AudioFormatReader& reader);
+    void clear();
+
+    bool isEmpty() const { return mLevels.empty(); }
+    juce::int64 getNumSamples() const { return mNumSamples; }
+    int getNumLevels() const { return static_cast<int> (mLevels.size()); }
+    int getSamplesPerPeak (int level) const { return baseSamplesPerPeak << level; }
+
+    // Fills one peak per pixel for the given sample range, using the coarsest
+    // level that still has at least one peak per pixel.
+    void getPeaks (juce::int64 startSample, juce::int64 numSamples, Peak* dest, int numPixels) const;
+
+    static constexpr int baseSamplesPerPeak { 16 };
+    static constexpr int readChunkSamples { baseSamplesPerPeak * 4096 };
+
+private:
+    static void appendBasePeaks (const juce::AudioBuffer<float>& source, int numSamples, std::vector<Peak>& dest);
+    void buildLevels (std::vector<Peak> base);
+
+    std::vector<std::vector<Peak>> mLevels;
+    juce::int64 mNumSamples { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PeakPyramid)
+};
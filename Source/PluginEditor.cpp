@@ -1,57 +1,73 @@
-/*
-  ==============================================================================
-
-    This file contains the basic framework code for a JUCE plugin editor.
-
-  ==============================================================================
-*/
-
-#include "PluginProcessor.h"
-#include "PluginEditor.h"
-
-//==============================================================================
-BasicSamplerAudioProcessorEditor::BasicSamplerAudioProcessorEditor (BasicSamplerAudioProcessor& p)
-    : AudioProcessorEditor (&p), mWaveThumbnail(p), mADSR(p), audioProcessor (p)
-{
-    // Make sure that before the constructor has finished, you've set the
-    // editor's size to whatever you need it to be.
-    auto psycheImage = juce::ImageCache::getFromMemory(BinaryData::PsycheCOVERHalfReso_png, BinaryData::PsycheCOVERHalfReso_pngSize);
-    
-    if (!psycheImage.isNull()) {
-        mImageComponent.setImage(psycheImage, juce::RectanglePlacement::xLeft);
-    } else {
-        jassert(!psycheImage.isNull());
-    }
-    
-    addAndMakeVisible(mWaveThumbnail);
-    addAndMakeVisible(mADSR);
-    addAndMakeVisible(mImageComponent);
-    
-    startTimerHz(30);
-    
-    setSize (800, 600);
-}
-
-BasicSamplerAudioProcessorEditor::~BasicSamplerAudioProcessorEditor()
-{
-    stopTimer();
-}
-
-//==============================================================================
-void BasicSamplerAudioProcessorEditor::paint (juce::Graphics& g)
-{
-    // (Our component is opaque, so we must completely fill the background with a solid colour)
-    g.fillAll (juce::Colours::white);
-}
-
-void BasicSamplerAudioProcessorEditor::resized()
-{
-    mWaveThumbnail.setBoundsRelative(0.0f, 0.25f, 1.0f, 0.5);
-    mADSR.setBoundsRelative(0.0f, 0.75f, 1.0f, 0.25f);
-    mImageComponent.setBoundsRelative(0.f, 0.f, 0.25f, 0.25f);
-}
-
-void BasicSamplerAudioProcessorEditor::timerCallback()
-{
-    repaint();
-}
+/*
+  ==============================================================================
+
+    This file contains the basic framework code for a JUCE plugin editor.
+
+  ==============================================================================
+*/
+
+#include "PluginProcessor.h"
+#include "PluginEditor.h"
+
+//==============================================================================
+BasicSamplerAudioProcessorEditor::BasicSamplerAudioProcessorEditor (BasicSamplerAudioProcessor& p)
+    : AudioProcessorEditor (&p), mWaveThumbnail(p), mADSR(p), mProfiler(p), audioProcessor (p)
+{
+    // Make sure that before the constructor has finished, you've set the
+    // editor's size to whatever you need it to be.
+    auto psycheImage = juce::ImageCache::getFromMemory(BinaryData::PsycheCOVERHalfReso_png, BinaryData::PsycheCOVERHalfReso_pngSize);
+    
+    if (!psycheImage.isNull()) {
+        mImageComponent.setImage(psycheImage, juce::RectanglePlacement::xLeft);
+    } else {
+        jassert(!psycheImage.isNull());
+    }
+    
+    mInterpolationBox.addItemList(VoiceRenderKernels::getInterpolationNames(), 1);
+    mInterpolationBox.setJustificationType(juce::Justification::centred);
+    mInterpolationAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(audioProcessor.getAPVTS(), "INTERPOLATION", mInterpolationBox);
+    
+    addAndMakeVisible(mWaveThumbnail);
+    addAndMakeVisible(mADSR);
+    addAndMakeVisible(mImageComponent);
+    addAndMakeVisible(mInterpolationBox);
+    addAndMakeVisible(mProfiler);
+    
+    startTimerHz(30);
+    
+    setSize (800, 600);
+}
+
+BasicSamplerAudioProcessorEditor::~BasicSamplerAudioProcessorEditor()
+{
+    stopTimer();
+}
+
+//==============================================================================
+void BasicSamplerAudioProcessorEditor::paint (juce::Graphics& g)
+{
+    // (Our component is opaque, so we must completely fill the background with a solid colour)
+    g.fillAll (juce::Colours::white);
+}
+
+void BasicSamplerAudioProcessorEditor::resized()
+{
+    mWaveThumbnail.setBoundsRelative(0.0f, 0.25f, 1.0f, 0.5);
+    mADSR.setBoundsRelative(0.0f, 0.75f, 1.0f, 0.25f);
+    mImageComponent.setBoundsRelative(0.f, 0.f, 0.25f, 0.25f);
+    mInterpolationBox.setBoundsRelative(0.78f, 0.04f, 0.2f, 0.05f);
+    mProfiler.setBoundsRelative(0.27f, 0.01f, 0.49f, 0.23f);
+}
+
+void BasicSamplerAudioProcessorEditor::timerCallback()
+{
+    mWaveThumbnail.updatePlayhead();
+    mProfiler.update();
+    
+    // Only poll at full rate while something is playing, release tails included
+    auto timerHz = audioProcessor.isNotePlayed() || mWaveThumbnail.hasActivePlayheads() ? 30 : 4;
+    
+    if (getTimerInterval() != 1000 / timerHz) {
+        startTimerHz(timerHz);
+    }
+}
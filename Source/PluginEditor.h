@@ -1,40 +1,45 @@
-/*
-  ==============================================================================
-
-    This file contains the basic framework code for a JUCE plugin editor.
-
-  ==============================================================================
-*/
-
-#pragma once
-
-#include <JuceHeader.h>
-#include "PluginProcessor.h"
-#include "WaveThumbnail.h"
-#include "ADSRComponent.h"
-
-//==============================================================================
-/**
-*/
-class BasicSamplerAudioProcessorEditor  : public juce::AudioProcessorEditor,
-                                          public juce::Timer
-{
-public:
-    BasicSamplerAudioProcessorEditor (BasicSamplerAudioProcessor&);
-    ~BasicSamplerAudioProcessorEditor() override;
-
-    //==============================================================================
-    void paint (juce::Graphics&) override;
-    void resized() override;
-    
-    void timerCallback() override;
-    
-private:
-    WaveThumbnail mWaveThumbnail;
-    ADSRComponent mADSR;
-    juce::ImageComponent mImageComponent;
-    
-    BasicSamplerAudioProcessor& audioProcessor;
-
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BasicSamplerAudioProcessorEditor)
-};
+/*
+  ==============================================================================
+
+    This file contains the basic framework code for a JUCE plugin editor.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+#include "WaveThumbnail.h"
+#include "ADSRComponent.h"
+#include "ProfilerComponent.h"
+
+//==============================================================================
+/**
+*/
+class BasicSamplerAudioProcessorEditor  : public juce::AudioProcessorEditor,
+                                          public juce::Timer
+{
+public:
+    BasicSamplerAudioProcessorEditor (BasicSamplerAudioProcessor&);
+    ~BasicSamplerAudioProcessorEditor() override;
+
+    //==============================================================================
+    void paint (juce::Graphics&) override;
+    void resized() override;
+    
+    void timerCallback() override;
+    
+private:
+    WaveThumbnail mWaveThumbnail;
+    ADSRComponent mADSR;
+    ProfilerComponent mProfiler;
+    juce::ImageComponent mImageComponent;
+    
+    juce::ComboBox mInterpolationBox;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> mInterpolationAttachment;
+    
+    BasicSamplerAudioProcessor& audioProcessor;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BasicSamplerAudioProcessorEditor)
+};
@@ -1,266 +1,457 @@
-/*
-  ==============================================================================
-
-    This file contains the basic framework code for a JUCE plugin processor.
-
-  ==============================================================================
-*/
-
-#include "PluginProcessor.h"
-#include "PluginEditor.h"
-
-//==============================================================================
-BasicSamplerAudioProcessor::BasicSamplerAudioProcessor()
-#ifndef JucePlugin_PreferredChannelConfigurations
-     : AudioProcessor (BusesProperties()
-                     #if ! JucePlugin_IsMidiEffect
-                      #if ! JucePlugin_IsSynth
-                       .withInput  ("Input",  juce::AudioChannelSet::stereo(), true)
-                      #endif
-                       .withOutput ("Output", juce::AudioChannelSet::stereo(), true)
-                     #endif
-                       ), mAPVTS(*this, nullptr, "PARAMETERS", createParameters())
-#endif
-{
-    mFormatManager.registerBasicFormats();
-    mAPVTS.state.addListener(this);
-    
-    for (int i = 0; i < mNumVoices; i++) {
-        mSampler.addVoice(new juce::SamplerVoice());
-    }
-}
-
-BasicSamplerAudioProcessor::~BasicSamplerAudioProcessor()
-{
-    delete mFormatReader;
-}
-
-//==============================================================================
-const juce::String BasicSamplerAudioProcessor::getName() const
-{
-    return JucePlugin_Name;
-}
-
-bool BasicSamplerAudioProcessor::acceptsMidi() const
-{
-   #if JucePlugin_WantsMidiInput
-    return true;
-   #else
-    return false;
-   #endif
-}
-
-bool BasicSamplerAudioProcessor::producesMidi() const
-{
-   #if JucePlugin_ProducesMidiOutput
-    return true;
-   #else
-    return false;
-   #endif
-}
-
-bool BasicSamplerAudioProcessor::isMidiEffect() const
-{
-   #if JucePlugin_IsMidiEffect
-    return true;
-   #else
-    return false;
-   #endif
-}
-
-double BasicSamplerAudioProcessor::getTailLengthSeconds() const
-{
-    return 0.0;
-}
-
-int BasicSamplerAudioProcessor::getNumPrograms()
-{
-    return 1;   // NB: some hosts don't cope very well if you tell them there are 0 programs,
-                // so this should be at least 1, even if you're not really implementing programs.
-}
-
-int BasicSamplerAudioProcessor::getCurrentProgram()
-{
-    return 0;
-}
-
-void BasicSamplerAudioProcessor::setCurrentProgram (int index)
-{
-}
-
-const juce::String BasicSamplerAudioProcessor::getProgramName (int index)
-{
-    return {};
-}
-
-void BasicSamplerAudioProcessor::changeProgramName (int index, const juce::String& newName)
-{
-}
-
-//==============================================================================
-void BasicSamplerAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
-{
-    mSampler.setCurrentPlaybackSampleRate(sampleRate);
-    updateADSR();
-}
-
-void BasicSamplerAudioProcessor::releaseResources()
-{
-    // When playback stops, you can use this as an opportunity to free up any
-    // spare memory, etc.
-}
-
-#ifndef JucePlugin_PreferredChannelConfigurations
-bool BasicSamplerAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts) const
-{
-  #if JucePlugin_IsMidiEffect
-    juce::ignoreUnused (layouts);
-    return true;
-  #else
-    // This is the place where you check if the layout is supported.
-    // In this template code we only support mono or stereo.
-    // Some plugin hosts, such as certain GarageBand versions, will only
-    // load plugins that support stereo bus layouts.
-    if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono()
-     && layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
-        return false;
-
-    // This checks if the input layout matches the output layout
-   #if ! JucePlugin_IsSynth
-    if (layouts.getMainOutputChannelSet() != layouts.getMainInputChannelSet())
-        return false;
-   #endif
-
-    return true;
-  #endif
-}
-#endif
-
-void BasicSamplerAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
-{
-    juce::ScopedNoDenormals noDenormals;
-    auto totalNumInputChannels  = getTotalNumInputChannels();
-    auto totalNumOutputChannels = getTotalNumOutputChannels();
-
-    for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
-        buffer.clear (i, 0, buffer.getNumSamples());
-    
-    if (mShouldUpdate) {
-        updateADSR();
-    }
-    
-    juce::MidiMessage m;
-    juce::MidiBuffer::Iterator it { midiMessages };
-    int sample;
-    
-    while (it.getNextEvent(m, sample)) {
-        if (m.isNoteOn()) {
-            mIsNotePlayed = true;
-        } else if (m.isNoteOff()) {
-            mIsNotePlayed = false;
-        }
-    }
-    
-    mSampleCount = mIsNotePlayed ? mSampleCount += buffer.getNumSamples() : 0;
-
-    mSampler.renderNextBlock(buffer, midiMessages, 0, buffer.getNumSamples());
-}
-
-//==============================================================================
-bool BasicSamplerAudioProcessor::hasEditor() const
-{
-    return true; // (change this to false if you choose to not supply an editor)
-}
-
-juce::AudioProcessorEditor* BasicSamplerAudioProcessor::createEditor()
-{
-    return new BasicSamplerAudioProcessorEditor (*this);
-}
-
-//==============================================================================
-void BasicSamplerAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
-{
-    // You should use this method to store your parameters in the memory block.
-    // You could do that either as raw data, or use the XML or ValueTree classes
-    // as intermediaries to make it easy to save and load complex data.
-}
-
-void BasicSamplerAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
-{
-    // You should use this method to restore your parameters from this memory block,
-    // whose contents will have been created by the getStateInformation() call.
-}
-
-void BasicSamplerAudioProcessor::loadFile()
-{
-    using namespace juce;
-    mSampler.clearSounds();
-    FileChooser chooser { "Please load a file" };
-    if (chooser.browseForFileToOpen()) {
-        auto file = chooser.getResult();
-        mFormatReader = mFormatManager.createReaderFor(file);
-    }
-    
-    BigInteger range;
-    range.setRange(0, 128, true);
-    
-    mSampler.addSound(new SamplerSound("Sample", *mFormatReader, range, 60, 0.0, 0.1, 10.0));
-}
-
-void BasicSamplerAudioProcessor::loadFile(const juce::String &path)
-{
-    using namespace juce;
-    mSampler.clearSounds();
-    auto file = File (path);
-    mFormatReader = mFormatManager.createReaderFor(file);
-    
-    auto sampleLength = static_cast<int>(mFormatReader->lengthInSamples);
-    
-    mWaveForm.setSize(1, sampleLength);
-    mFormatReader->read(&mWaveForm, 0, sampleLength, 0, true, false);
-    
-    BigInteger range;
-    range.setRange(0, 128, true);
-    
-    mSampler.addSound(new SamplerSound("Sample", *mFormatReader, range, 60, 0.0, 0.1, 10.0));
-    
-    updateADSR();
-}
-
-void BasicSamplerAudioProcessor::updateADSR()
-{
-    mADSRParams.attack = mAPVTS.getRawParameterValue("ATTACK")->load();
-    mADSRParams.decay = mAPVTS.getRawParameterValue("DECAY")->load();
-    mADSRParams.sustain = mAPVTS.getRawParameterValue("SUSTAIN")->load();
-    mADSRParams.release = mAPVTS.getRawParameterValue("RELEASE")->load();
-    
-    for (int i = 0; i < mSampler.getNumSounds(); ++i) {
-        if (auto sound = dynamic_cast<juce::SamplerSound*>(mSampler.getSound(i).get())) {
-            sound->setEnvelopeParameters(mADSRParams);
-        }
-    }
-}
-
-juce::AudioProcessorValueTreeState::ParameterLayout BasicSamplerAudioProcessor::createParameters() 
-{
-    std::vector<std::unique_ptr<juce::RangedAudioParameter>> parameters;
-    
-    parameters.push_back(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID{ "ATTACK", 1 }, "Attack", 0.0f, 5.0f, 0.0f));
-    parameters.push_back(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID{ "DECAY", 1 }, "Decay", 0.0f, 3.0f, 2.0f));
-    parameters.push_back(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID{ "SUSTAIN", 1 }, "Sustain", 0.0f, 1.0f, 1.0f));
-    parameters.push_back(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID{ "RELEASE", 1 }, "Release", 0.0f, 5.0f, 0.75f));
-    
-    return { parameters.begin(), parameters.end() };
-}
-
-void BasicSamplerAudioProcessor::valueTreePropertyChanged(juce::ValueTree &treeWhosePropertyHasChanged, const juce::Identifier &property)
-{
-    mShouldUpdate = true;
-}
-
-//==============================================================================
-// This creates new instances of the plugin..
-juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
-{
-    return new BasicSamplerAudioProcessor();
-}
+/*
+  ==============================================================================
+
+    This file contains the basic framework code for a JUCE plugin processor.
+
+  ==============================================================================
+*/
+
+#include "PluginProcessor.h"
+#include "PluginEditor.h"
+
+//==============================================================================
+BasicSamplerAudioProcessor::BasicSamplerAudioProcessor()
+#ifndef JucePlugin_PreferredChannelConfigurations
+     : AudioProcessor (BusesProperties()
+                     #if ! JucePlugin_IsMidiEffect
+                      #if ! JucePlugin_IsSynth
+                       .withInput  ("Input",  juce::AudioChannelSet::stereo(), true)
+                      #endif
+                       .withOutput ("Output", juce::AudioChannelSet::stereo(), true)
+                     #endif
+                       ), mAPVTS(*this, nullptr, "PARAMETERS", createParameters())
+#endif
+{
+    mFormatManager.registerBasicFormats();
+    
+    mReleasePool.onRelease = [this] (juce::ReferenceCountedObject* object) {
+        if (auto* sound = dynamic_cast<StreamingSamplerSound*>(object)) {
+            mStreamer.removeSound(sound);
+        }
+    };
+    mLoader.onLoaded = [this] (std::unique_ptr<SampleLoader::LoadedSample> loaded) { handleLoadedSample(std::move(loaded)); };
+    
+   #if JUCE_DEBUG
+    // The vectorised voice kernels must stay interchangeable with the scalar one
+    jassert(VoiceRenderKernels::measureMaxErrorAgainstScalar() < 1.0e-4f);
+   #endif
+    
+    VoiceRenderKernels::prepareTables();
+    TimeStretcher::prepareTables();
+    updatePolyphony();
+    
+    mSampler.setEnvelopeControllerRanges(mAPVTS.getParameterRange("ATTACK"),
+                                         mAPVTS.getParameterRange("DECAY"),
+                                         mAPVTS.getParameterRange("RELEASE"));
+}
+
+BasicSamplerAudioProcessor::~BasicSamplerAudioProcessor()
+{
+    mStreamer.removeAllVoices();
+}
+
+//==============================================================================
+const juce::String BasicSamplerAudioProcessor::getName() const
+{
+    return JucePlugin_Name;
+}
+
+bool BasicSamplerAudioProcessor::acceptsMidi() const
+{
+   #if JucePlugin_WantsMidiInput
+    return true;
+   #else
+    return false;
+   #endif
+}
+
+bool BasicSamplerAudioProcessor::producesMidi() const
+{
+   #if JucePlugin_ProducesMidiOutput
+    return true;
+   #else
+    return false;
+   #endif
+}
+
+bool BasicSamplerAudioProcessor::isMidiEffect() const
+{
+   #if JucePlugin_IsMidiEffect
+    return true;
+   #else
+    return false;
+   #endif
+}
+
+double BasicSamplerAudioProcessor::getTailLengthSeconds() const
+{
+    return 0.0;
+}
+
+int BasicSamplerAudioProcessor::getNumPrograms()
+{
+    return 1;   // NB: some hosts don't cope very well if you tell them there are 0 programs,
+                // so this should be at least 1, even if you're not really implementing programs.
+}
+
+int BasicSamplerAudioProcessor::getCurrentProgram()
+{
+    return 0;
+}
+
+void BasicSamplerAudioProcessor::setCurrentProgram (int index)
+{
+}
+
+const juce::String BasicSamplerAudioProcessor::getProgramName (int index)
+{
+    return {};
+}
+
+void BasicSamplerAudioProcessor::changeProgramName (int index, const juce::String& newName)
+{
+}
+
+//==============================================================================
+void BasicSamplerAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
+{
+    mSampler.setCurrentPlaybackSampleRate(sampleRate);
+    mProfiler.setSampleRate(sampleRate);
+    updatePolyphony();
+    
+    // Bounces render on every core there is, with the best interpolation
+    mOffline = isNonRealtime();
+    auto numRenderThreads = mOffline ? VoiceRenderPool::maxThreads
+                                     : static_cast<int>(mParameters.get(ParameterEngine::renderThreads));
+    mSampler.prepare(numRenderThreads, getTotalNumOutputChannels(), samplesPerBlock, mOffline);
+    
+    // Let the first block push every parameter through to the synth
+    mParameters.markAllChanged();
+}
+
+void BasicSamplerAudioProcessor::releaseResources()
+{
+    // No point keeping the render workers spinning while nothing is playing
+    mSampler.releaseRenderThreads();
+    
+    if (RealtimeChecker::compiledIn) {
+        if (auto report = RealtimeChecker::takeReport(); report.isNotEmpty()) {
+            juce::Logger::writeToLog(report);
+        }
+    }
+}
+
+#ifndef JucePlugin_PreferredChannelConfigurations
+bool BasicSamplerAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts) const
+{
+  #if JucePlugin_IsMidiEffect
+    juce::ignoreUnused (layouts);
+    return true;
+  #else
+    // This is the place where you check if the layout is supported.
+    // In this template code we only support mono or stereo.
+    // Some plugin hosts, such as certain GarageBand versions, will only
+    // load plugins that support stereo bus layouts.
+    if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono()
+     && layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
+        return false;
+
+    // This checks if the input layout matches the output layout
+   #if ! JucePlugin_IsSynth
+    if (layouts.getMainOutputChannelSet() != layouts.getMainInputChannelSet())
+        return false;
+   #endif
+
+    return true;
+  #endif
+}
+#endif
+
+void BasicSamplerAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
+{
+    // Everything from here on has to be realtime safe, RT check builds report anything that isn't
+    const RealtimeChecker::ScopedRealtime realtime;
+    juce::ScopedNoDenormals noDenormals;
+    auto totalNumInputChannels  = getTotalNumInputChannels();
+    auto totalNumOutputChannels = getTotalNumOutputChannels();
+    
+    // Nothing the release pool holds is freed while we might be halfway through picking it up
+    const ReleasePool::AudioThreadScope releaseScope (mReleasePool);
+    
+    mProfiler.beginBlock(buffer.getNumSamples());
+
+    for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
+        buffer.clear (i, 0, buffer.getNumSamples());
+    
+    {
+        AudioThreadProfiler::ScopedStage stage (mProfiler, AudioThreadProfiler::zoneSwap);
+        
+        if (auto* zoneMap = mPendingZoneMap.exchange(nullptr)) {
+            // Ringing notes finish on the old instrument, held keys optionally crossfade over
+            auto crossfadeMs = mParameters.get(ParameterEngine::swapCrossfade);
+            mSampler.setZoneMap(zoneMap, juce::roundToInt(crossfadeMs * 0.001 * getSampleRate()));
+        }
+    }
+    
+    juce::uint32 changes = 0;
+    
+    {
+        AudioThreadProfiler::ScopedStage stage (mProfiler, AudioThreadProfiler::parameters);
+        changes = mParameters.takeChanges();
+        
+        if (changes & ParameterEngine::envelopeChanges) {
+            updateADSR();
+        }
+        
+        // Hosts may start or stop bouncing without preparing again, the render
+        // threads and buffer sizes then wait for the next prepareToPlay
+        if (isNonRealtime() != mOffline) {
+            mOffline = isNonRealtime();
+            mSampler.setOffline(mOffline);
+            updateInterpolation();
+        } else if (changes & ParameterEngine::changed(ParameterEngine::interpolation)) {
+            updateInterpolation();
+        }
+        
+        if (changes & ParameterEngine::stretchChanges) {
+            updateStretch();
+        }
+        
+        if (changes & ParameterEngine::filterChanges) {
+            updateFilter();
+        }
+    }
+    
+    {
+        AudioThreadProfiler::ScopedStage stage (mProfiler, AudioThreadProfiler::render);
+        
+        // Splits the block at every event, note-ons and controllers land on their exact sample
+        mSampler.renderNextBlock(buffer, midiMessages, 0, buffer.getNumSamples());
+    }
+    
+    mIsNotePlayed = mSampler.getNumKeysDown() > 0;
+    
+    // The counters cost a little to gather, so only while profiling
+    if (mProfiler.isMeasuring()) {
+        mProfiler.endBlock(mSampler.getNumActiveVoices(), midiMessages.getNumEvents(),
+                           juce::countNumberOfBits(changes), mStreamer.getNumUnderruns());
+    }
+}
+
+//==============================================================================
+bool BasicSamplerAudioProcessor::hasEditor() const
+{
+    return true; // (change this to false if you choose to not supply an editor)
+}
+
+juce::AudioProcessorEditor* BasicSamplerAudioProcessor::createEditor()
+{
+    return new BasicSamplerAudioProcessorEditor (*this);
+}
+
+//==============================================================================
+void BasicSamplerAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
+{
+    SamplerState::Snapshot snapshot;
+    
+    {
+        const juce::ScopedLock sl(mStateLock);
+        snapshot = mInstrument;
+    }
+    
+    snapshot.parameters = mAPVTS.copyState();
+    SamplerState::write(snapshot, destData);
+}
+
+void BasicSamplerAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
+{
+    SamplerState::Snapshot snapshot;
+    
+    if (!SamplerState::read(data, sizeInBytes, snapshot)) {
+        return;
+    }
+    
+    // Parameters apply straight away, the samples are left to the loader threads
+    // so a project full of instances opens without waiting on the disk
+    if (snapshot.parameters.hasType(mAPVTS.state.getType())) {
+        mAPVTS.replaceState(snapshot.parameters);
+        mParameters.markAllChanged();
+    }
+    
+    snapshot.parameters = {};
+    
+    if (!snapshot.zones.empty()) {
+        mLoader.restoreAsync(snapshot.source, snapshot.zones, snapshot.fingerprints, snapshot.storage,
+                             mParameters.getPreprocessingSettings());
+    }
+    
+    // Saving again before the load finishes mustn't lose the instrument
+    const juce::ScopedLock sl(mStateLock);
+    mInstrument = std::move(snapshot);
+}
+
+void BasicSamplerAudioProcessor::loadFile()
+{
+    using namespace juce;
+    FileChooser chooser { "Please load a file, an SFZ or a folder of samples" };
+    if (chooser.browseForFileOrDirectory()) {
+        loadFile(chooser.getResult().getFullPathName());
+    }
+}
+
+void BasicSamplerAudioProcessor::loadFile(const juce::String &path)
+{
+    // An audio file, an SFZ file or a folder of samples. Decoding happens on the
+    // loader threads, handleLoadedSample() picks it up from there. The storage
+    // and preprocessing settings only apply to what's loaded after they change.
+    auto storage = static_cast<CompactSampleBuffer::Format>(static_cast<int>(mParameters.get(ParameterEngine::storage)));
+    mLoader.loadAsync(juce::File (path), storage, mParameters.getPreprocessingSettings());
+}
+
+void BasicSamplerAudioProcessor::handleLoadedSample(std::unique_ptr<SampleLoader::LoadedSample> loaded)
+{
+    auto* zoneMap = loaded->zoneMap.get();
+    auto envelope = mParameters.getEnvelopeParameters();
+    
+    for (auto* sound : zoneMap->getSounds()) {
+        sound->setEnvelopeParameters(envelope);
+        mReleasePool.add(sound);
+        mStreamer.addSound(sound);
+    }
+    
+    mReleasePool.add(zoneMap);
+    mLatestZoneMap = zoneMap;
+    
+    {
+        const juce::ScopedLock sl(mStateLock);
+        mInstrument.source = loaded->file;
+        mInstrument.storage = loaded->storage;
+        mInstrument.zones = std::move(loaded->zones);
+        mInstrument.fingerprints = std::move(loaded->fingerprints);
+    }
+    
+    // If the audio thread never got round to the previous map it just stays in the pool
+    mPendingZoneMap.exchange(zoneMap);
+    
+    mPeaks = loaded->peaks;
+    sendChangeMessage();
+}
+
+const PeakPyramid& BasicSamplerAudioProcessor::getPeaks() const
+{
+    static const PeakPyramid empty;
+    return mPeaks != nullptr ? mPeaks->getPyramid() : empty;
+}
+
+void BasicSamplerAudioProcessor::updateADSR()
+{
+    mADSRParams = mParameters.getEnvelopeParameters();
+    mSampler.setEnvelopeParameters(mADSRParams);
+}
+
+void BasicSamplerAudioProcessor::updateInterpolation()
+{
+    // Offline there's time for the best one, whatever the parameter says
+    auto interpolation = mOffline ? VoiceRenderKernels::Interpolation::windowedSinc
+                                  : static_cast<VoiceRenderKernels::Interpolation>(static_cast<int>(mParameters.get(ParameterEngine::interpolation)));
+    
+    if (interpolation == mInterpolation) {
+        return;
+    }
+    
+    mInterpolation = interpolation;
+    
+    for (int i = 0; i < mSampler.getNumVoices(); ++i) {
+        if (auto voice = dynamic_cast<StreamingSamplerVoice*>(mSampler.getVoice(i))) {
+            voice->setInterpolation(interpolation);
+        }
+    }
+}
+
+void BasicSamplerAudioProcessor::updateStretch()
+{
+    // Notes already sounding carry on as they started
+    auto settings = mParameters.getStretchSettings();
+    
+    for (int i = 0; i < mSampler.getNumVoices(); ++i) {
+        if (auto voice = dynamic_cast<StreamingSamplerVoice*>(mSampler.getVoice(i))) {
+            voice->setStretchSettings(settings);
+        }
+    }
+}
+
+void BasicSamplerAudioProcessor::updateFilter()
+{
+    // Cutoff, resonance and type follow the knobs on ringing notes too, the filter envelope doesn't
+    mSampler.setFilterParameters(mParameters.getFilterParameters());
+}
+
+void BasicSamplerAudioProcessor::updatePolyphony()
+{
+    // Voices allocate their rings, so the pool only ever changes size here,
+    // ahead of mSampler.prepare() laying out the rest of their buffers
+    auto numVoices = juce::jlimit(1, VoicePlayheads::maxVoices, static_cast<int>(mParameters.get(ParameterEngine::polyphony)));
+    
+    if (numVoices == mSampler.getPolyphony()) {
+        return;
+    }
+    
+    mSampler.setPolyphony(numVoices, [this] {
+        auto voice = new StreamingSamplerVoice();
+        voice->setPlayheadSlot(&mPlayheads, mSampler.getNumVoices());
+        voice->setInterpolation(mInterpolation);
+        mStreamer.addVoice(voice);
+        return voice;
+    });
+    
+    mPlayheads.setNumVoices(numVoices);
+}
+
+juce::AudioProcessorValueTreeState::ParameterLayout BasicSamplerAudioProcessor::createParameters() 
+{
+    std::vector<std::unique_ptr<juce::RangedAudioParameter>> parameters;
+    
+    parameters.push_back(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID{ "ATTACK", 1 }, "Attack", 0.0f, 5.0f, 0.0f));
+    parameters.push_back(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID{ "DECAY", 1 }, "Decay", 0.0f, 3.0f, 2.0f));
+    parameters.push_back(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID{ "SUSTAIN", 1 }, "Sustain", 0.0f, 1.0f, 1.0f));
+    parameters.push_back(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID{ "RELEASE", 1 }, "Release", 0.0f, 5.0f, 0.75f));
+    parameters.push_back(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID{ "INTERPOLATION", 1 }, "Interpolation", VoiceRenderKernels::getInterpolationNames(), 0));
+    parameters.push_back(std::make_unique<juce::AudioParameterInt>(juce::ParameterID{ "POLYPHONY", 1 }, "Polyphony", 1, VoicePlayheads::maxVoices, 32));
+    parameters.push_back(std::make_unique<juce::AudioParameterInt>(juce::ParameterID{ "RENDER_THREADS", 1 }, "Render Threads", 1, VoiceRenderPool::maxThreads, 1));
+    parameters.push_back(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID{ "STORAGE", 1 }, "Sample Storage", CompactSampleBuffer::getFormatNames(), 0));
+    parameters.push_back(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID{ "SWAP_CROSSFADE", 1 }, "Swap Crossfade", 0.0f, 1000.0f, 0.0f));
+    parameters.push_back(std::make_unique<juce::AudioParameterBool>(juce::ParameterID{ "TRIM", 1 }, "Trim Silence", false));
+    parameters.push_back(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID{ "NORMALISE", 1 }, "Normalise", SamplePreprocessor::getNormalisationNames(), 0));
+    parameters.push_back(std::make_unique<juce::AudioParameterBool>(juce::ParameterID{ "AUTO_LOOP", 1 }, "Auto Loop", false));
+    parameters.push_back(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID{ "PLAYBACK", 1 }, "Playback", TimeStretcher::getPlaybackNames(), 0));
+    
+    // Normal speed in the middle of the range
+    juce::NormalisableRange<float> speedRange (0.25f, 4.0f);
+    speedRange.setSkewForCentre(1.0f);
+    parameters.push_back(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID{ "STRETCH_SPEED", 1 }, "Stretch Speed", speedRange, 1.0f));
+    parameters.push_back(std::make_unique<juce::AudioParameterInt>(juce::ParameterID{ "GRAINS", 1 }, "Grains", TimeStretcher::minGrains, TimeStretcher::maxGrains, 4));
+    parameters.push_back(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID{ "FILTER_TYPE", 1 }, "Filter", VoiceFilter::getTypeNames(), 0));
+    
+    // Cutoff and resonance both sweep logarithmically
+    juce::NormalisableRange<float> cutoffRange (VoiceFilter::minCutoff, 20000.0f);
+    cutoffRange.setSkewForCentre(1000.0f);
+    juce::NormalisableRange<float> resonanceRange (VoiceFilter::minResonance, VoiceFilter::maxResonance);
+    resonanceRange.setSkewForCentre(2.0f);
+    
+    parameters.push_back(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID{ "FILTER_CUTOFF", 1 }, "Cutoff", cutoffRange, 20000.0f));
+    parameters.push_back(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID{ "FILTER_RESONANCE", 1 }, "Resonance", resonanceRange, 0.707f));
+    parameters.push_back(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID{ "FILTER_ENV_AMOUNT", 1 }, "Filter Env Amount", -8.0f, 8.0f, 0.0f));
+    parameters.push_back(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID{ "FILTER_ATTACK", 1 }, "Filter Attack", 0.0f, 5.0f, 0.0f));
+    parameters.push_back(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID{ "FILTER_DECAY", 1 }, "Filter Decay", 0.0f, 3.0f, 2.0f));
+    parameters.push_back(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID{ "FILTER_SUSTAIN", 1 }, "Filter Sustain", 0.0f, 1.0f, 1.0f));
+    parameters.push_back(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID{ "FILTER_RELEASE", 1 }, "Filter Release", 0.0f, 5.0f, 0.75f));
+    
+    return { parameters.begin(), parameters.end() };
+}
+
+//==============================================================================
+// This creates new instances of the plugin..
+juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
+{
+    return new BasicSamplerAudioProcessor();
+}
@@ -1,90 +1,134 @@
-/*
-  ==============================================================================
-
-    This file contains the basic framework code for a JUCE plugin processor.
-
-  ==============================================================================
-*/
-
-#pragma once
-
-#include <JuceHeader.h>
-
-//==============================================================================
-/**
-*/
-class BasicSamplerAudioProcessor  : public juce::AudioProcessor,
-                                    public juce::ValueTree::Listener
-{
-public:
-    //==============================================================================
-    BasicSamplerAudioProcessor();
-    ~BasicSamplerAudioProcessor() override;
-
-    //==============================================================================
-    void prepareToPlay (double sampleRate, int samplesPerBlock) override;
-    void releaseResources() override;
-
-   #ifndef JucePlugin_PreferredChannelConfigurations
-    bool isBusesLayoutSupported (const BusesLayout& layouts) const override;
-   #endif
-
-    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
-
-    //==============================================================================
-    juce::AudioProcessorEditor* createEditor() override;
-    bool hasEditor() const override;
-
-    //==============================================================================
-    const juce::String getName() const override;
-
-    bool acceptsMidi() const override;
-    bool producesMidi() const override;
-    bool isMidiEffect() const override;
-    double getTailLengthSeconds() const override;
-
-    //==============================================================================
-    int getNumPrograms() override;
-    int getCurrentProgram() override;
-    void setCurrentProgram (int index) override;
-    const juce::String getProgramName (int index) override;
-    void changeProgramName (int index, const juce::String& newName) override;
-
-    //==============================================================================
-    void getStateInformation (juce::MemoryBlock& destData) override;
-    void setStateInformation (const void* data, int sizeInBytes) override;
-    
-    void loadFile();
-    void loadFile (const juce::String& path);
-    
-    int getNumSamplerSounds() { return mSampler.getNumSounds(); }
-    juce::AudioBuffer<float>& getWaveForm() { return mWaveForm; }
-    
-    void updateADSR();
-    
-    juce::ADSR::Parameters& getADSRParams() { return mADSRParams; }
-    juce::AudioProcessorValueTreeState& getAPVTS() { return mAPVTS; }
-    
-    std::atomic<bool>& isNotePlayed() { return mIsNotePlayed; }
-    std::atomic<int>& getSampleCount() { return mSampleCount; }
-
-private:
-    juce::Synthesiser mSampler;
-    const int mNumVoices { 8 };
-    juce::AudioBuffer<float> mWaveForm;
-    
-    juce::ADSR::Parameters mADSRParams;
-    
-    juce::AudioFormatManager mFormatManager;
-    juce::AudioFormatReader* mFormatReader { nullptr };
-    
-    juce::AudioProcessorValueTreeState mAPVTS;
-    juce::AudioProcessorValueTreeState::ParameterLayout createParameters();
-    void valueTreePropertyChanged (juce::ValueTree& treeWhosePropertyHasChanged, const juce::Identifier& property) override;
-    
-    std::atomic<bool> mShouldUpdate { false };
-    std::atomic<bool> mIsNotePlayed { false };
-    std::atomic<int> mSampleCount { 0 };
-    //==============================================================================
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BasicSamplerAudioProcessor)
-};
+/*
+  ==============================================================================
+
+    This file contains the basic framework code for a JUCE plugin processor.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "StreamingSamplerSound.h"
+#include "StreamingSamplerVoice.h"
+#include "SampleStreamer.h"
+#include "SamplerSynthesiser.h"
+#include "SampleLoader.h"
+#include "ReleasePool.h"
+#include "PeakPyramid.h"
+#include "SampleCache.h"
+#include "VoicePlayheads.h"
+#include "ParameterEngine.h"
+#include "SamplerState.h"
+#include "AudioThreadProfiler.h"
+#include "RealtimeChecker.h"
+
+//==============================================================================
+/**
+*/
+class BasicSamplerAudioProcessor  : public juce::AudioProcessor,
+                                    public juce::ChangeBroadcaster
+{
+public:
+    //==============================================================================
+    BasicSamplerAudioProcessor();
+    ~BasicSamplerAudioProcessor() override;
+
+    //==============================================================================
+    void prepareToPlay (double sampleRate, int samplesPerBlock) override;
+    void releaseResources() override;
+
+   #ifndef JucePlugin_PreferredChannelConfigurations
+    bool isBusesLayoutSupported (const BusesLayout& layouts) const override;
+   #endif
+
+    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+
+    //==============================================================================
+    juce::AudioProcessorEditor* createEditor() override;
+    bool hasEditor() const override;
+
+    //==============================================================================
+    const juce::String getName() const override;
+
+    bool acceptsMidi() const override;
+    bool producesMidi() const override;
+    bool isMidiEffect() const override;
+    double getTailLengthSeconds() const override;
+
+    //==============================================================================
+    int getNumPrograms() override;
+    int getCurrentProgram() override;
+    void setCurrentProgram (int index) override;
+    const juce::String getProgramName (int index) override;
+    void changeProgramName (int index, const juce::String& newName) override;
+
+    //==============================================================================
+    void getStateInformation (juce::MemoryBlock& destData) override;
+    void setStateInformation (const void* data, int sizeInBytes) override;
+    
+    void loadFile();
+    void loadFile (const juce::String& path);
+    
+    // Message thread
+    int getNumZones() const { return mLatestZoneMap != nullptr ? mLatestZoneMap->getNumZones() : 0; }
+    // Message thread
+    const PeakPyramid& getPeaks() const;
+    
+    void updateADSR();
+    void updateInterpolation();
+    void updateStretch();
+    void updateFilter();
+    void updatePolyphony();
+    
+    juce::ADSR::Parameters& getADSRParams() { return mADSRParams; }
+    juce::AudioProcessorValueTreeState& getAPVTS() { return mAPVTS; }
+    
+    std::atomic<bool>& isNotePlayed() { return mIsNotePlayed; }
+    const VoicePlayheads& getPlayheads() const { return mPlayheads; }
+    
+    int getNumStreamUnderruns() const { return mStreamer.getNumUnderruns(); }
+    AudioThreadProfiler& getProfiler() { return mProfiler; }
+
+private:
+    // Declared before mSampler as the voices publish into it
+    VoicePlayheads mPlayheads;
+    
+    SamplerSynthesiser mSampler;
+    SampleCache::Peaks::Ptr mPeaks;   // shared with any other instance showing the same file
+    
+    juce::ADSR::Parameters mADSRParams;
+    
+    juce::AudioFormatManager mFormatManager;
+    
+    // Instruments travel loader -> message thread -> mPendingZoneMap -> audio thread.
+    // The release pool keeps every map and sound alive until nothing else refers to it.
+    ZoneMap::Ptr mLatestZoneMap;
+    std::atomic<ZoneMap*> mPendingZoneMap { nullptr };
+    ReleasePool mReleasePool;
+    
+    // Declared after mSampler so the disk thread stops before the voices go away
+    SampleStreamer mStreamer;
+    
+    SampleLoader mLoader { mFormatManager };
+    void handleLoadedSample (std::unique_ptr<SampleLoader::LoadedSample> loaded);
+    
+    // The loaded instrument as it's saved with the state. Hosts may ask for
+    // the state from any thread, so it's only touched under mStateLock.
+    juce::CriticalSection mStateLock;
+    SamplerState::Snapshot mInstrument;
+    
+    juce::AudioProcessorValueTreeState mAPVTS;
+    juce::AudioProcessorValueTreeState::ParameterLayout createParameters();
+    
+    // Declared after mAPVTS, it looks every parameter up once on construction
+    ParameterEngine mParameters { mAPVTS };
+    VoiceRenderKernels::Interpolation mInterpolation { VoiceRenderKernels::Interpolation::linear };
+    bool mOffline { false };   // audio thread, whether the host was bouncing as of the last block
+    
+    std::atomic<bool> mIsNotePlayed { false };
+    
+    AudioThreadProfiler mProfiler;
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BasicSamplerAudioProcessor)
+};
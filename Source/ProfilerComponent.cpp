@@ -0,0 +1,109 @@
+/*
+  ==============================================================================
+
+    ProfilerComponent.cpp
+    Created: 18 Oct 2026 1:02:44am
+    Author:  Adam Chung
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "ProfilerComponent.h"
+
+//==============================================================================
+ProfilerComponent::ProfilerComponent(BasicSamplerAudioProcessor& p) : audioProcessor(p)
+{
+    auto& profiler = audioProcessor.getProfiler();
+    
+    mEnableButton.setColour(juce::ToggleButton::ColourIds::textColourId, juce::Colours::black);
+    mEnableButton.setColour(juce::ToggleButton::ColourIds::tickColourId, juce::Colours::red);
+    mEnableButton.setColour(juce::ToggleButton::ColourIds::tickDisabledColourId, juce::Colours::black);
+    mEnableButton.setToggleState(profiler.isEnabled(), juce::NotificationType::dontSendNotification);
+    mEnableButton.setEnabled(AudioThreadProfiler::compiledIn);
+    mEnableButton.onClick = [this] { audioProcessor.getProfiler().setEnabled(mEnableButton.getToggleState()); };
+    addAndMakeVisible(mEnableButton);
+    
+    mResetButton.onClick = [this] {
+        audioProcessor.getProfiler().reset();
+        mStatus.clear();
+        update();
+    };
+    addAndMakeVisible(mResetButton);
+    
+    mDumpButton.onClick = [this] { dump(); };
+    addAndMakeVisible(mDumpButton);
+    
+    update();
+}
+
+ProfilerComponent::~ProfilerComponent()
+{
+}
+
+void ProfilerComponent::paint (juce::Graphics& g)
+{
+    g.fillAll(juce::Colours::white);
+    
+    const auto& histogram = mStatistics.stages[AudioThreadProfiler::total];
+    auto bounds = getLocalBounds().reduced(4);
+    auto textArea = bounds.removeFromBottom(32);
+    auto plotArea = bounds.withTrimmedTop(24).toFloat();
+    
+    g.setColour(juce::Colours::lightgrey);
+    g.drawRect(plotArea);
+    
+    // One bar per quarter octave of block time, scaled to the fullest bucket
+    auto largest = *std::max_element(histogram.counts.begin(), histogram.counts.end());
+    
+    if (largest > 0) {
+        auto barWidth = plotArea.getWidth() / AudioThreadProfiler::Histogram::numBuckets;
+        g.setColour(juce::Colours::red);
+        
+        for (int i = 0; i < AudioThreadProfiler::Histogram::numBuckets; ++i) {
+            auto height = plotArea.getHeight() * static_cast<float>(histogram.counts[static_cast<size_t>(i)]) / static_cast<float>(largest);
+            g.fillRect(plotArea.getX() + i * barWidth, plotArea.getBottom() - height, juce::jmax(1.0f, barWidth - 1.0f), height);
+        }
+    }
+    
+    g.setColour(juce::Colours::black);
+    g.setFont(10.0f);
+    
+    auto summary = juce::String("block p50 ") + juce::String(histogram.getPercentileMicros(0.5), 1)
+                 + "us  p99 " + juce::String(histogram.getPercentileMicros(0.99), 1)
+                 + "us  max " + juce::String(histogram.maxMicros, 1)
+                 + "us  overruns " + juce::String(mStatistics.numOverruns)
+                 + "  voices " + juce::String(mStatistics.maxVoices);
+    
+    g.drawText(summary, textArea.removeFromTop(16), juce::Justification::centredLeft);
+    g.drawText(mStatus, textArea, juce::Justification::centredLeft);
+}
+
+void ProfilerComponent::resized()
+{
+    mEnableButton.setBoundsRelative(0.0f, 0.0f, 0.3f, 0.15f);
+    mResetButton.setBoundsRelative(0.55f, 0.0f, 0.2f, 0.15f);
+    mDumpButton.setBoundsRelative(0.78f, 0.0f, 0.2f, 0.15f);
+}
+
+void ProfilerComponent::update()
+{
+    auto statistics = audioProcessor.getProfiler().getStatistics();
+    
+    if (statistics.numBlocks == mStatistics.numBlocks) {
+        return;
+    }
+    
+    mStatistics = std::move(statistics);
+    repaint();
+}
+
+void ProfilerComponent::dump()
+{
+    auto file = juce::File::getSpecialLocation(juce::File::userDocumentsDirectory)
+                    .getChildFile("BasicSampler Profile.txt")
+                    .getNonexistentSibling();
+    
+    mStatus = audioProcessor.getProfiler().dumpToFile(file) ? "Saved " + file.getFullPathName() : "Couldn't write " + file.getFullPathName();
+    repaint();
+}
@@ -0,0 +1,46 @@
+/*
+  ==============================================================================
+
+    ProfilerComponent.h
+    Created: 18 Oct 2026 1:02:44am
+    Author:  Adam Chung
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+
+//==============================================================================
+/*
+    Switches the audio thread profiler on and off, draws the histogram of
+    whole-block times, and dumps the full statistics to a text file.
+*/
+class ProfilerComponent  : public juce::Component
+{
+public:
+    ProfilerComponent(BasicSamplerAudioProcessor& p);
+    ~ProfilerComponent() override;
+
+    void paint (juce::Graphics&) override;
+    void resized() override;
+    
+    // Called from the editor's timer
+    void update();
+
+private:
+    void dump();
+    
+    juce::ToggleButton mEnableButton { "Profile" };
+    juce::TextButton mResetButton { "Reset" };
+    juce::TextButton mDumpButton { "Dump" };
+    
+    AudioThreadProfiler::Statistics mStatistics;
+    juce::String mStatus;
+    
+    BasicSamplerAudioProcessor& audioProcessor;
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ProfilerComponent)
+};
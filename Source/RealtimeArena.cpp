@@ -0,0 +1,63 @@
+/*
+  ==============================================================================
+
+    RealtimeArena.cpp
+    Created: 18 Oct 2026 2:47:53am
+    Author:  Adam Chung
+
+  ==============================================================================
+*/
+
+#include "RealtimeArena.h"
+
+//==============================================================================
+RealtimeArena::RealtimeArena()
+{
+}
+
+RealtimeArena::~RealtimeArena()
+{
+}
+
+void RealtimeArena::reset (size_t numBytes)
+{
+    // Room to line the start up too, HeapBlock only promises malloc's alignment
+    mBlock.calloc (numBytes + alignment);
+
+    auto address = reinterpret_cast<juce::pointer_sized_uint> (mBlock.getData());
+    mStart = mBlock.getData() + ((alignment - address % alignment) % alignment);
+    mCapacity = numBytes;
+    mNumBytesUsed = 0;
+}
+
+void* RealtimeArena::allocateBytes (size_t numBytes)
+{
+    auto size = getSizeFor<char> (numBytes);
+
+    if (mNumBytesUsed + size > mCapacity) {
+        jassertfalse; // the size given to reset() didn't add up
+        return nullptr;
+    }
+
+    auto* data = mStart + mNumBytesUsed;
+    mNumBytesUsed += size;
+    return data;
+}
+
+void RealtimeArena::allocateBuffer (juce::AudioBuffer<float>& buffer, int numChannels, int numSamples)
+{
+    jassert (numChannels <= maxBufferChannels);
+
+    float* channels[maxBufferChannels] {};
+
+    for (int ch = 0; ch < numChannels; ++ch) {
+        channels[ch] = allocate<float> (static_cast<size_t> (numSamples));
+
+        if (channels[ch] == nullptr) {
+            buffer.setSize (0, 0);
+            return;
+        }
+    }
+
+    buffer.setDataToReferTo (channels, numChannels, numSamples);
+}
@@ -0,0 +1,75 @@
+/*
+  ==============================================================================
+
+    RealtimeArena.h
+    Created: 18 Oct 2026 2:47:53am
+    Author:  Adam Chung
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/*
+    One block of memory that everything the audio path works in is carved out
+    of: the voices' scratch, envelope and fade-out buffers and the render
+    pool's per-thread mixes.
+
+    It's laid out in prepareToPlay, where the total size is known, and handed
+    out front to back in cache line aligned pieces. Nothing is ever freed on its
+    own, the whole arena is thrown away and laid out again the next time the
+    audio settings change, so the audio thread never allocates anything and all
+    of its working memory sits together.
+*/
+class RealtimeArena
+{
+public:
+    RealtimeArena();
+    ~RealtimeArena();
+
+    // Not for the audio thread. Throws away everything handed out so far and
+    // makes room for numBytes, as added up with getSizeFor().
+    void reset (size_t numBytes);
+
+    // Not for the audio thread. Zeroed and aligned, or nullptr once the arena
+    // has run out of room.
+    template <typename Type>
+    Type* allocate (size_t numElements)
+    {
+        return static_cast<Type*> (allocateBytes (numElements * sizeof (Type)));
+    }
+
+    // Points buffer at numChannels x numSamples floats of the arena
+    void allocateBuffer (juce::AudioBuffer<float>& buffer, int numChannels, int numSamples);
+
+    // What an allocation takes up, padding included
+    template <typename Type>
+    static constexpr size_t getSizeFor (size_t numElements)
+    {
+        return (numElements * sizeof (Type) + alignment - 1) & ~(alignment - 1);
+    }
+
+    static constexpr size_t getBufferSizeFor (int numChannels, int numSamples)
+    {
+        return static_cast<size_t> (numChannels) * getSizeFor<float> (static_cast<size_t> (numSamples));
+    }
+
+    size_t getCapacity() const { return mCapacity; }
+    size_t getNumBytesUsed() const { return mNumBytesUsed; }
+
+    static constexpr size_t alignment { 64 };   // a cache line
+    static constexpr int maxBufferChannels { 8 };
+
+private:
+    void* allocateBytes (size_t numBytes);
+
+    juce::HeapBlock<char> mBlock;
+    char* mStart { nullptr };
+    size_t mCapacity { 0 };
+    size_t mNumBytesUsed { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (RealtimeArena)
+};
@@ -0,0 +1,398 @@
+/*
+  ==============================================================================
+
+    RealtimeChecker.cpp
+    Created: 18 Oct 2026 3:02:26am
+    Author:  Adam Chung
+
+  ==============================================================================
+*/
+
+// The fortified inline versions of read() and write() would clash with the wrappers below
+#if BASICSAMPLER_RT_CHECKS && defined (_FORTIFY_SOURCE)
+ #undef _FORTIFY_SOURCE
+#endif
+
+#include "RealtimeChecker.h"
+
+#if BASICSAMPLER_RT_CHECKS
+
+#if JUCE_LINUX && defined (__GLIBC__)
+ #include <dlfcn.h>
+ #include <execinfo.h>
+ #include <pthread.h>
+ #include <sched.h>
+ #include <time.h>
+ #include <unistd.h>
+ #define BASICSAMPLER_RT_HOOK_LIBC 1
+#else
+ #define BASICSAMPLER_RT_HOOK_LIBC 0
+#endif
+
+#if JUCE_MAC
+ #include <execinfo.h>
+#endif
+
+// Initial-exec so that looking them up never allocates, from inside malloc of all places
+#if JUCE_LINUX
+ #define BASICSAMPLER_RT_THREAD_LOCAL thread_local __attribute__ ((tls_model ("initial-exec")))
+#else
+ #define BASICSAMPLER_RT_THREAD_LOCAL thread_local
+#endif
+
+namespace
+{
+    using RealtimeChecker::Violation;
+
+    BASICSAMPLER_RT_THREAD_LOCAL int realtimeDepth = 0;
+    BASICSAMPLER_RT_THREAD_LOCAL int allowanceDepth = 0;
+    BASICSAMPLER_RT_THREAD_LOCAL bool isRecording = false;
+
+    struct Record
+    {
+        std::atomic<bool> isComplete { false };
+        Violation violation { Violation::allocation };
+        const char* function { nullptr };
+        int numFrames { 0 };
+        void* frames[RealtimeChecker::maxStackFrames] {};
+    };
+
+    // Filled front to back and never reused, the first ones are usually all it takes
+    Record records[RealtimeChecker::maxRecords];
+    std::atomic<int> numClaimed { 0 };
+    std::atomic<int> numViolations { 0 };
+    int numReported { 0 };   // message thread
+
+    constexpr int maxAllowedLocks { 8 };
+    std::atomic<const void*> allowedLocks[maxAllowedLocks] {};
+
+    int captureStack (void** frames, int maxFrames)
+    {
+       #if JUCE_LINUX || JUCE_MAC
+        return backtrace (frames, maxFrames);
+       #else
+        juce::ignoreUnused (frames, maxFrames);
+        return 0;
+       #endif
+    }
+
+    // The first backtrace() loads the unwinder, which allocates, so that's done up front
+    const int stackWarmUp = [] {
+        void* frames[1];
+        return captureStack (frames, 1);
+    }();
+
+    void record (Violation violation, const char* function)
+    {
+        if (realtimeDepth == 0 || allowanceDepth > 0 || isRecording) {
+            return;
+        }
+
+        // Whatever gets called from here on is ours, not the audio path's
+        isRecording = true;
+        numViolations.fetch_add (1, std::memory_order_relaxed);
+
+        auto slot = numClaimed.fetch_add (1, std::memory_order_relaxed);
+
+        if (slot < RealtimeChecker::maxRecords) {
+            auto& r = records[slot];
+            r.violation = violation;
+            r.function = function;
+            r.numFrames = captureStack (r.frames, RealtimeChecker::maxStackFrames);
+            r.isComplete.store (true, std::memory_order_release);
+        }
+
+        isRecording = false;
+    }
+
+    bool isAllowedLock (const void* mutex)
+    {
+        for (auto& allowed : allowedLocks) {
+            if (allowed.load (std::memory_order_relaxed) == mutex) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    juce::String getViolationName (Violation violation)
+    {
+        switch (violation) {
+            case Violation::allocation:   return "allocation";
+            case Violation::deallocation: return "deallocation";
+            case Violation::lock:         return "lock";
+            case Violation::systemCall:   return "system call";
+        }
+
+        return {};
+    }
+}
+
+//==============================================================================
+RealtimeChecker::ScopedRealtime::ScopedRealtime()    { ++realtimeDepth; }
+RealtimeChecker::ScopedRealtime::~ScopedRealtime()   { --realtimeDepth; }
+RealtimeChecker::ScopedAllowance::ScopedAllowance()  { ++allowanceDepth; }
+RealtimeChecker::ScopedAllowance::~ScopedAllowance() { --allowanceDepth; }
+
+void RealtimeChecker::allowLock (const void* mutex)
+{
+    if (isAllowedLock (mutex)) {
+        return;
+    }
+
+    for (auto& allowed : allowedLocks) {
+        const void* empty = nullptr;
+
+        if (allowed.compare_exchange_strong (empty, mutex)) {
+            return;
+        }
+    }
+
+    jassertfalse; // raise maxAllowedLocks
+}
+
+int RealtimeChecker::getNumViolations()
+{
+    return numViolations.load();
+}
+
+juce::String RealtimeChecker::takeReport()
+{
+    juce::String report;
+    auto numRecorded = juce::jmin (numClaimed.load(), maxRecords);
+
+    for (; numReported < numRecorded; ++numReported) {
+        auto& r = records[numReported];
+
+        // Still being written, it'll be in the next report
+        if (!r.isComplete.load (std::memory_order_acquire)) {
+            break;
+        }
+
+        report << "Realtime violation: " << getViolationName (r.violation) << " in " << r.function << juce::newLine;
+
+       #if JUCE_LINUX || JUCE_MAC
+        if (auto* symbols = backtrace_symbols (r.frames, r.numFrames)) {
+            // Frame 0 is record() itself and frame 1 the wrapper, neither is news
+            for (int i = 2; i < r.numFrames; ++i) {
+                report << "    " << symbols[i] << juce::newLine;
+            }
+
+            ::free (symbols);
+        }
+       #endif
+    }
+
+    if (numReported == maxRecords && numViolations.load() > maxRecords) {
+        report << (numViolations.load() - maxRecords) << " more violations weren't recorded" << juce::newLine;
+    }
+
+    return report;
+}
+
+//==============================================================================
+#if BASICSAMPLER_RT_HOOK_LIBC
+
+extern "C"
+{
+    // glibc's own entry points, so the allocation wrappers never have to look anything up
+    void* __libc_malloc (size_t);
+    void* __libc_calloc (size_t, size_t);
+    void* __libc_realloc (void*, size_t);
+    void* __libc_memalign (size_t, size_t);
+    void __libc_free (void*);
+}
+
+namespace
+{
+    // The next definition along, i.e. the C library's. All of them are looked up
+    // while the process starts, so a wrapper never calls into the dynamic linker.
+    template <typename Function>
+    Function* getNext (std::atomic<void*>& cache, const char* name)
+    {
+        auto* function = cache.load (std::memory_order_relaxed);
+
+        if (function == nullptr) {
+            function = dlsym (RTLD_NEXT, name);
+            cache.store (function, std::memory_order_relaxed);
+        }
+
+        return reinterpret_cast<Function*> (function);
+    }
+
+    std::atomic<void*> nextMutexLock, nextCondWait, nextCondTimedWait;
+    std::atomic<void*> nextRead, nextWrite, nextNanosleep, nextUsleep, nextSchedYield;
+
+    const bool nextResolved = [] {
+        getNext<decltype (pthread_mutex_lock)> (nextMutexLock, "pthread_mutex_lock");
+        getNext<decltype (pthread_cond_wait)> (nextCondWait, "pthread_cond_wait");
+        getNext<decltype (pthread_cond_timedwait)> (nextCondTimedWait, "pthread_cond_timedwait");
+        getNext<decltype (read)> (nextRead, "read");
+        getNext<decltype (write)> (nextWrite, "write");
+        getNext<decltype (nanosleep)> (nextNanosleep, "nanosleep");
+        getNext<decltype (usleep)> (nextUsleep, "usleep");
+        getNext<decltype (sched_yield)> (nextSchedYield, "sched_yield");
+        return true;
+    }();
+}
+
+extern "C"
+{
+    void* malloc (size_t size) noexcept
+    {
+        record (Violation::allocation, "malloc");
+        return __libc_malloc (size);
+    }
+
+    void* calloc (size_t numElements, size_t size) noexcept
+    {
+        record (Violation::allocation, "calloc");
+        return __libc_calloc (numElements, size);
+    }
+
+    void* realloc (void* data, size_t size) noexcept
+    {
+        record (Violation::allocation, "realloc");
+        return __libc_realloc (data, size);
+    }
+
+    void* memalign (size_t alignment, size_t size) noexcept
+    {
+        record (Violation::allocation, "memalign");
+        return __libc_memalign (alignment, size);
+    }
+
+    void* aligned_alloc (size_t alignment, size_t size) noexcept
+    {
+        record (Violation::allocation, "aligned_alloc");
+        return __libc_memalign (alignment, size);
+    }
+
+    int posix_memalign (void** result, size_t alignment, size_t size) noexcept
+    {
+        if (alignment % sizeof (void*) != 0 || !juce::isPowerOfTwo (alignment)) {
+            return EINVAL;
+        }
+
+        record (Violation::allocation, "posix_memalign");
+
+        if (auto* data = __libc_memalign (alignment, size)) {
+            *result = data;
+            return 0;
+        }
+
+        return ENOMEM;
+    }
+
+    void free (void* data) noexcept
+    {
+        if (data != nullptr) {
+            record (Violation::deallocation, "free");
+        }
+
+        __libc_free (data);
+    }
+
+    int pthread_mutex_lock (pthread_mutex_t* mutex) noexcept
+    {
+        if (!isAllowedLock (mutex)) {
+            record (Violation::lock, "pthread_mutex_lock");
+        }
+
+        return getNext<decltype (pthread_mutex_lock)> (nextMutexLock, "pthread_mutex_lock") (mutex);
+    }
+
+    int pthread_cond_wait (pthread_cond_t* condition, pthread_mutex_t* mutex)
+    {
+        record (Violation::lock, "pthread_cond_wait");
+        return getNext<decltype (pthread_cond_wait)> (nextCondWait, "pthread_cond_wait") (condition, mutex);
+    }
+
+    int pthread_cond_timedwait (pthread_cond_t* condition, pthread_mutex_t* mutex, const timespec* time)
+    {
+        record (Violation::lock, "pthread_cond_timedwait");
+        return getNext<decltype (pthread_cond_timedwait)> (nextCondTimedWait, "pthread_cond_timedwait") (condition, mutex, time);
+    }
+
+    ssize_t read (int fd, void* data, size_t size)
+    {
+        record (Violation::systemCall, "read");
+        return getNext<decltype (read)> (nextRead, "read") (fd, data, size);
+    }
+
+    ssize_t write (int fd, const void* data, size_t size)
+    {
+        record (Violation::systemCall, "write");
+        return getNext<decltype (write)> (nextWrite, "write") (fd, data, size);
+    }
+
+    int nanosleep (const timespec* duration, timespec* remaining)
+    {
+        record (Violation::systemCall, "nanosleep");
+        return getNext<decltype (nanosleep)> (nextNanosleep, "nanosleep") (duration, remaining);
+    }
+
+    int usleep (useconds_t microseconds)
+    {
+        record (Violation::systemCall, "usleep");
+        return getNext<decltype (usleep)> (nextUsleep, "usleep") (microseconds);
+    }
+
+    int sched_yield() noexcept
+    {
+        record (Violation::systemCall, "sched_yield");
+        return getNext<decltype (sched_yield)> (nextSchedYield, "sched_yield")();
+    }
+}
+
+#else
+
+//==============================================================================
+// Without the C library's functions to wrap, C++ allocations are still caught
+void* operator new (size_t size)
+{
+    record (Violation::allocation, "operator new");
+
+    if (auto* data = std::malloc (size)) {
+        return data;
+    }
+
+    throw std::bad_alloc();
+}
+
+void* operator new[] (size_t size)
+{
+    record (Violation::allocation, "operator new[]");
+
+    if (auto* data = std::malloc (size)) {
+        return data;
+    }
+
+    throw std::bad_alloc();
+}
+
+void operator delete (void* data) noexcept
+{
+    if (data != nullptr) {
+        record (Violation::deallocation, "operator delete");
+    }
+
+    std::free (data);
+}
+
+void operator delete[] (void* data) noexcept
+{
+    if (data != nullptr) {
+        record (Violation::deallocation, "operator delete[]");
+    }
+
+    std::free (data);
+}
+
+void operator delete (void* data, size_t) noexcept    { operator delete (data); }
+void operator delete[] (void* data, size_t) noexcept  { operator delete[] (data); }
+
+#endif
+
+#endif
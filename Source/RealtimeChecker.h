@@ -0,0 +1,88 @@
+/*
+  ==============================================================================
+
+    RealtimeChecker.h
+    Created: 18 Oct 2026 3:02:26am
+    Author:  Adam Chung
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Set to 1 to report everything on the audio thread that could block
+#ifndef BASICSAMPLER_RT_CHECKS
+ #define BASICSAMPLER_RT_CHECKS 0
+#endif
+
+//==============================================================================
+/*
+    A build mode for proving the audio path realtime safe.
+
+    With BASICSAMPLER_RT_CHECKS set, the C library's allocation functions, the
+    pthread mutex and condition variable calls and the common blocking system
+    calls are wrapped, and any of them made by a thread inside a ScopedRealtime
+    is recorded along with a stack trace. The records sit in a fixed table, so
+    recording one never allocates or locks itself; takeReport() symbolises them
+    later, off the audio thread.
+
+    Replacing the C library's functions only reaches the whole process when the
+    checker is linked into the executable: the standalone app and the benchmark,
+    on Linux. Everywhere else only C++ new and delete are caught.
+
+    Without BASICSAMPLER_RT_CHECKS all of it compiles away to nothing.
+*/
+namespace RealtimeChecker
+{
+    enum class Violation { allocation, deallocation, lock, systemCall };
+
+    // Marks the calling thread as realtime while it's alive. Nests.
+    class ScopedRealtime
+    {
+    public:
+        ScopedRealtime();
+        ~ScopedRealtime();
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedRealtime)
+    };
+
+    // Lets the calling thread do anything while it's alive, for the few calls
+    // that have been looked at and are known to be bounded. Nests.
+    class ScopedAllowance
+    {
+    public:
+        ScopedAllowance();
+        ~ScopedAllowance();
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedAllowance)
+    };
+
+    // Not for the audio thread. Locking this mutex is never reported, for locks
+    // that are only ever contended while the audio isn't running. A
+    // juce::CriticalSection can be passed straight in, it's a bare pthread mutex.
+    void allowLock (const void* mutex);
+
+    // Any thread. Every violation so far, including any that didn't fit in the table.
+    int getNumViolations();
+
+    // Not for the audio thread. One entry per violation recorded since the last
+    // call, with its stack trace, empty if there were none.
+    juce::String takeReport();
+
+    static constexpr bool compiledIn { BASICSAMPLER_RT_CHECKS != 0 };
+    static constexpr int maxRecords { 256 };
+    static constexpr int maxStackFrames { 32 };
+}
+
+//==============================================================================
+#if ! BASICSAMPLER_RT_CHECKS
+inline RealtimeChecker::ScopedRealtime::ScopedRealtime() {}
+inline RealtimeChecker::ScopedRealtime::~ScopedRealtime() {}
+inline RealtimeChecker::ScopedAllowance::ScopedAllowance() {}
+inline RealtimeChecker::ScopedAllowance::~ScopedAllowance() {}
+inline void RealtimeChecker::allowLock (const void*) {}
+inline int RealtimeChecker::getNumViolations() { return 0; }
+inline juce::String RealtimeChecker::takeReport() { return {}; }
+#endif
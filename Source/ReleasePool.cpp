@@ -0,0 +1,61 @@
+/*
+  ==============================================================================
+
+    ReleasePool.cpp
+    Created: 17 Oct 2026 11:18:30am
+    Author:  Adam Chung
+
+  ==============================================================================
+*/
+
+#include "ReleasePool.h"
+
+//==============================================================================
+ReleasePool::ReleasePool()
+{
+    startTimer (1000);
+}
+
+ReleasePool::~ReleasePool()
+{
+    stopTimer();
+}
+
+void ReleasePool::add (juce::ReferenceCountedObject* object)
+{
+    if (object != nullptr) {
+        mEntries.push_back ({ object });
+    }
+}
+
+void ReleasePool::timerCallback()
+{
+    // The epoch is read before the count: if the audio thread was outside a block
+    // then, any pointer it took earlier has long since become a reference. Inside
+    // a block, the object has to wait for that block to finish. A zone map going
+    // frees its sounds up to follow on later ticks.
+    for (auto& entry : mEntries) {
+        auto epoch = mAudioEpoch.load();
+
+        if (entry.object->getReferenceCount() > 1) {
+            entry.unusedSinceEpoch = notUnused;
+        } else if ((epoch & 1) == 0) {
+            entry.releasable = true;
+        } else if (entry.unusedSinceEpoch == notUnused) {
+            entry.unusedSinceEpoch = epoch;
+        } else {
+            entry.releasable = entry.unusedSinceEpoch != epoch;
+        }
+    }
+
+    auto firstReleased = std::stable_partition (mEntries.begin(), mEntries.end(),
+                                                [] (const Entry& e) { return !e.releasable; });
+
+    for (auto it = firstReleased; it != mEntries.end(); ++it) {
+        if (onRelease != nullptr) {
+            onRelease (it->object.get());
+        }
+    }
+
+    mEntries.erase (firstReleased, mEntries.end());
+}
@@ -0,0 +1,73 @@
+/*
+  ==============================================================================
+
+    ReleasePool.h
+    Created: 17 Oct 2026 11:18:30am
+    Author:  Adam Chung
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/*
+    Deferred-free queue for sounds and zone maps handed to the audio thread.
+
+    The pool holds a reference to every object it's given, so the last reference
+    can never be dropped by a voice or the synth on the audio thread. A timer on
+    the message thread deletes objects once the pool is the only owner left.
+
+    The audio thread may still be holding a raw pointer it has taken, e.g. from
+    a pending zone map, but not yet turned into a reference. It wraps every
+    block in an AudioThreadScope, which bumps an epoch counter on the way in
+    and out, and an unused object is only deleted once the audio thread has
+    been seen outside a block, or has finished the block it was in, since the
+    object was first seen unused.
+*/
+class ReleasePool  : private juce::Timer
+{
+public:
+    ReleasePool();
+    ~ReleasePool() override;
+
+    void add (juce::ReferenceCountedObject* object);
+
+    // Called on the message thread just before an object is deleted
+    std::function<void (juce::ReferenceCountedObject*)> onRelease;
+
+    //==============================================================================
+    // Audio thread. Marks one block, lock-free.
+    class AudioThreadScope
+    {
+    public:
+        explicit AudioThreadScope (ReleasePool& pool) : mPool (pool) { mPool.mAudioEpoch.fetch_add (1); }
+        ~AudioThreadScope() { mPool.mAudioEpoch.fetch_add (1); }
+
+    private:
+        ReleasePool& mPool;
+
+        JUCE_DECLARE_NON_COPYABLE (AudioThreadScope)
+    };
+
+private:
+    void timerCallback() override;
+
+    static constexpr juce::uint64 notUnused { std::numeric_limits<juce::uint64>::max() };
+
+    struct Entry
+    {
+        juce::ReferenceCountedObjectPtr<juce::ReferenceCountedObject> object;
+        juce::uint64 unusedSinceEpoch { notUnused };
+        bool releasable { false };
+    };
+
+    std::vector<Entry> mEntries;
+
+    // Odd while the audio thread is inside a block
+    std::atomic<juce::uint64> mAudioEpoch { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ReleasePool)
+};
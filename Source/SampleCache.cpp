@@ -0,0 +1,175 @@
+/*
+  ==============================================================================
+
+    SampleCache.cpp
+    Created: 17 Oct 2026 10:06:18pm
+    Author:  Adam Chung
+
+  ==============================================================================
+*/
+
+#include "SampleCache.h"
+#include "SamplerState.h"
+
+//==============================================================================
+SampleCache::SampleCache()
+{
+}
+
+SampleCache::~SampleCache()
+{
+}
+
+juce::String SampleCache::makeKey (const juce::File& file, const juce::String& format)
+{
+    // An edited file gets a new key, so nobody is handed stale audio
+    return file.getFullPathName()
+         + "|" + juce::String (file.getLastModificationTime().toMilliseconds())
+         + "|" + format;
+}
+
+SampleCache::Sample::Ptr SampleCache::getSample (const juce::File& file, int numPreloadFrames,
+                                                 CompactSampleBuffer::Format storage,
+                                                 const SamplePreprocessor::Settings& preprocessing,
+                                                 juce::AudioFormatManager& formatManager)
+{
+    // Mapped files only depend on the preprocessing, decoded heads on everything
+    auto mappedKey = makeKey (file, "mapped/" + preprocessing.toString());
+    auto key = makeKey (file, juce::String (numPreloadFrames) + "/" + juce::String (static_cast<int> (storage))
+                                + "/" + preprocessing.toString());
+
+    Sample::Ptr mappedSample;
+
+    {
+        const juce::ScopedLock sl (mLock);
+
+        if (auto it = mSamples.find (mappedKey); it != mSamples.end()) {
+            mappedSample = it->second;
+        } else if (auto it = mSamples.find (key); it != mSamples.end()) {
+            return it->second;
+        }
+    }
+
+    if (mappedSample != nullptr) {
+        // Whoever mapped it may have faulted in a shorter head. Outside the
+        // lock, this can wait on the disk.
+        mappedSample->touchMapped (0, numPreloadFrames);
+        return mappedSample;
+    }
+
+    Sample::Ptr sample = new Sample();
+    sample->mFile = file;
+
+    // Only ever taken here, on the way in, so a cached load still reads nothing
+    sample->mFingerprint = SamplerState::fingerprint (file);
+
+    if (auto* format = formatManager.findFormatForFileExtension (file.getFileExtension())) {
+        std::unique_ptr<juce::MemoryMappedAudioFormatReader> mapped { format->createMemoryMappedReader (file) };
+
+        if (mapped != nullptr && mapped->mapEntireFile()) {
+            sample->mPreprocessing = SamplePreprocessor::process (file, *mapped, preprocessing);
+            sample->mSampleRate = mapped->sampleRate;
+            sample->mLength = sample->mPreprocessing.length;
+            sample->mMapped = std::move (mapped);
+        }
+    }
+
+    if (sample->isMapped()) {
+        // Fault the head in now so notes can start without waiting on the disk
+        sample->touchMapped (0, numPreloadFrames);
+    } else {
+        std::unique_ptr<juce::AudioFormatReader> reader { formatManager.createReaderFor (file) };
+
+        if (reader == nullptr) {
+            return nullptr;
+        }
+
+        sample->mPreprocessing = SamplePreprocessor::process (file, *reader, preprocessing);
+        sample->mSampleRate = reader->sampleRate;
+        sample->mLength = sample->mPreprocessing.length;
+        sample->mPreloadLength = static_cast<int> (juce::jmin<juce::int64> (sample->mLength, numPreloadFrames));
+
+        // Always stereo so voices never have to care about the file's channel count.
+        // Trimmed silence is never read, let alone kept.
+        juce::AudioBuffer<float> head (2, sample->mPreloadLength);
+        head.clear();
+        reader->read (&head, 0, sample->mPreloadLength, sample->getStartFrame(), true, true);
+
+        if (reader->usesFloatingPointData || reader->bitsPerSample > 16) {
+            storage = CompactSampleBuffer::Format::float32;
+        }
+
+        sample->mPreload.store (head, sample->mPreloadLength, storage);
+    }
+
+    const juce::ScopedLock sl (mLock);
+
+    // Another thread may have got there first, everybody shares whichever went in first
+    return mSamples.emplace (sample->isMapped() ? mappedKey : key, sample).first->second;
+}
+
+SampleCache::Peaks::Ptr SampleCache::getPeaks (const juce::File& file, juce::AudioFormatManager& formatManager)
+{
+    auto key = makeKey (file, "peaks");
+
+    {
+        const juce::ScopedLock sl (mLock);
+
+        if (auto it = mPeaks.find (key); it != mPeaks.end()) {
+            return it->second;
+        }
+    }
+
+    std::unique_ptr<juce::AudioFormatReader> reader { formatManager.createReaderFor (file) };
+
+    if (reader == nullptr) {
+        return nullptr;
+    }
+
+    // Streamed through a chunk at a time, every channel, however long the file
+    Peaks::Ptr peaks = new Peaks();
+    peaks->mPyramid.build (*reader);
+
+    const juce::ScopedLock sl (mLock);
+    return mPeaks.emplace (key, peaks).first->second;
+}
+
+//==============================================================================
+void SampleCache::Sample::readMapped (juce::AudioBuffer<float>& dest, int destStartFrame, int numFrames, juce::int64 sourceStartFrame) const
+{
+    // Reading a mapping doesn't touch any reader state, so sharing one is safe
+    mMapped->read (&dest, destStartFrame, numFrames, getStartFrame() + sourceStartFrame, true, true);
+}
+
+void SampleCache::Sample::touchMapped (juce::int64 startFrame, juce::int64 numFrames) const
+{
+    constexpr int pageBytes = 4096;
+    auto bytesPerFrame = juce::jmax (1, static_cast<int> (mMapped->numChannels * mMapped->bitsPerSample / 8));
+    auto framesPerPage = juce::jmax (1, pageBytes / bytesPerFrame);
+    auto end = juce::jmin (mLength, startFrame + numFrames);
+
+    for (auto frame = juce::jmax<juce::int64> (0, startFrame); frame < end; frame += framesPerPage) {
+        mMapped->touchSample (getStartFrame() + frame);
+    }
+}
+
+//==============================================================================
+int SampleCache::getNumSamples() const
+{
+    const juce::ScopedLock sl (mLock);
+    return static_cast<int> (mSamples.size());
+}
+
+void SampleCache::purgeUnused()
+{
+    const juce::ScopedLock sl (mLock);
+
+    auto purge = [] (auto& entries) {
+        for (auto it = entries.begin(); it != entries.end();) {
+            it = it->second->getReferenceCount() == 1 ? entries.erase (it) : std::next (it);
+        }
+    };
+
+    purge (mSamples);
+    purge (mPeaks);
+}
@@ -0,0 +1,137 @@
+/*
+  ==============================================================================
+
+    SampleCache.h
+    Created: 17 Oct 2026 10:06:18pm
+    Author:  Adam Chung
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "PeakPyramid.h"
+#include "CompactSampleBuffer.h"
+#include "SamplePreprocessor.h"
+
+//==============================================================================
+/*
+    Decoded sample data shared by every plugin instance in the process.
+
+    Entries are keyed by file path, modification time, decode format and
+    preprocessing settings, and
+    are immutable once built, so any number of sounds in any number of
+    instances can read them at once. An instance loading a file another one
+    already holds gets the same entry back without touching the disk.
+
+    The cache only keeps entries somebody else still refers to: whatever
+    nobody uses any more is dropped by purgeUnused(), which the loader runs
+    before every load.
+
+    Get hold of it through a juce::SharedResourcePointer<SampleCache>.
+*/
+class SampleCache
+{
+public:
+    // The resident head of a file plus what's needed to stream the rest.
+    //
+    // Uncompressed WAV and AIFF files are memory-mapped instead: nothing is
+    // decoded up front, and voices convert frames straight out of the mapping,
+    // which the OS page cache shares between every instance and process.
+    class Sample  : public juce::ReferenceCountedObject
+    {
+    public:
+        using Ptr = juce::ReferenceCountedObjectPtr<Sample>;
+
+        const juce::File& getFile() const { return mFile; }
+        bool isMapped() const { return mMapped != nullptr; }
+
+        // The file's SamplerState::fingerprint(), taken when the entry was built
+        juce::uint64 getFingerprint() const { return mFingerprint; }
+
+        // Mapped samples only. Reading converts to float on the way, any thread
+        // can call either, but frames that haven't been touched may page fault.
+        void readMapped (juce::AudioBuffer<float>& dest, int destStartFrame, int numFrames, juce::int64 sourceStartFrame) const;
+        void touchMapped (juce::int64 startFrame, juce::int64 numFrames) const;
+
+        // Stereo, in whichever storage format the sample was asked for with
+        const CompactSampleBuffer& getPreloadBuffer() const { return mPreload; }
+        int getPreloadLength() const { return mPreloadLength; }
+        juce::int64 getLength() const { return mLength; }
+        double getSampleRate() const { return mSampleRate; }
+
+        // Frames are counted from where preprocessing trimmed the file to start,
+        // which is getStartFrame() into the file itself
+        juce::int64 getStartFrame() const { return mPreprocessing.start; }
+        float getGain() const { return mPreprocessing.gain; }
+        bool hasLoop() const { return mPreprocessing.hasLoop(); }
+        juce::int64 getLoopStart() const { return mPreprocessing.loopStart; }
+        juce::int64 getLoopEnd() const { return mPreprocessing.loopEnd; }
+
+    private:
+        friend class SampleCache;
+        Sample() = default;
+
+        juce::File mFile;
+        juce::uint64 mFingerprint { 0 };
+        std::unique_ptr<juce::MemoryMappedAudioFormatReader> mMapped;
+        CompactSampleBuffer mPreload;   // empty when mapped
+        int mPreloadLength { 0 };
+        juce::int64 mLength { 0 };
+        double mSampleRate { 0.0 };
+        SamplePreprocessor::Result mPreprocessing;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Sample)
+    };
+
+    // A whole file's peak pyramid, for drawing
+    class Peaks  : public juce::ReferenceCountedObject
+    {
+    public:
+        using Ptr = juce::ReferenceCountedObjectPtr<Peaks>;
+
+        const PeakPyramid& getPyramid() const { return mPyramid; }
+
+    private:
+        friend class SampleCache;
+        Peaks() = default;
+
+        PeakPyramid mPyramid;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Peaks)
+    };
+
+    SampleCache();
+    ~SampleCache();
+
+    // Any thread but the audio thread. Null if the file can't be read.
+    //
+    // Heads of files deeper than 16 bits are kept as float whatever storage is
+    // asked for, so compact storage never loses anything. The file is run
+    // through the SamplePreprocessor first, unless the settings are neutral.
+    // A file that's memory mapped has no head to keep, so it's shared whatever
+    // preload length and storage are asked for.
+    Sample::Ptr getSample (const juce::File& file, int numPreloadFrames,
+                           CompactSampleBuffer::Format storage,
+                           const SamplePreprocessor::Settings& preprocessing,
+                           juce::AudioFormatManager& formatManager);
+    Peaks::Ptr getPeaks (const juce::File& file, juce::AudioFormatManager& formatManager);
+
+    void purgeUnused();
+    int getNumSamples() const;
+
+private:
+    static juce::String makeKey (const juce::File& file, const juce::String& format);
+
+    template <typename ObjectType>
+    using Entries = std::unordered_map<juce::String, juce::ReferenceCountedObjectPtr<ObjectType>>;
+
+    // Held while looking up and inserting only, files are read without it so
+    // loads on other threads and in other instances can carry on
+    mutable juce::CriticalSection mLock;
+    Entries<Sample> mSamples;
+    Entries<Peaks> mPeaks;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SampleCache)
+};
@@ -0,0 +1,266 @@
+/*
+  ==============================================================================
+
+    SampleLoader.cpp
+    Created: 17 Oct 2026 11:34:08am
+    Author:  Adam Chung
+
+  ==============================================================================
+*/
+
+#include "SampleLoader.h"
+#include "ZoneImporter.h"
+#include "SamplerState.h"
+
+//==============================================================================
+// Builds the sounds of zones taken from a shared counter, so however the zones
+// vary in size every decode thread stays busy until the last one is done.
+class SampleLoader::DecodeJob  : public juce::ThreadPoolJob
+{
+public:
+    struct Batch
+    {
+        std::vector<ZoneMap::Description>& zones;
+        std::vector<juce::ReferenceCountedObjectPtr<StreamingSamplerSound>>& sounds;
+        std::vector<juce::uint64>& fingerprints;   // what a restore expects on the way in, what was found on the way out
+        juce::File sourceFolder;
+        int numPreloadFrames;
+        CompactSampleBuffer::Format storage;
+        SamplePreprocessor::Settings preprocessing;
+
+        std::atomic<size_t> nextZone { 0 };
+        std::atomic<int> numRunning { 0 };
+        std::atomic<bool> cancelled { false };
+        juce::WaitableEvent finished;
+    };
+
+    DecodeJob (juce::AudioFormatManager& fm, SampleCache& c, Batch& b)
+        : juce::ThreadPoolJob ("Sample Decode"), formatManager (fm), cache (c), batch (b)
+    {
+    }
+
+    JobStatus runJob() override
+    {
+        using namespace juce;
+
+        for (auto i = batch.nextZone++; i < batch.zones.size() && !isCancelled(); i = batch.nextZone++) {
+            auto& zone = batch.zones[i];
+            auto expected = batch.fingerprints[i];
+
+            if (expected != 0) {
+                findMovedSample (zone.file, expected);
+            }
+
+            // Each step can read a whole file, so a cancelled load stops after
+            // whichever it's in rather than at the end of the zone
+            if (isCancelled()) {
+                break;
+            }
+
+            auto sample = cache.getSample (zone.file, batch.numPreloadFrames, batch.storage, batch.preprocessing, formatManager);
+
+            if (sample == nullptr || isCancelled()) {
+                continue;
+            }
+
+            batch.fingerprints[i] = sample->getFingerprint();
+
+            if (expected != 0 && expected != sample->getFingerprint()) {
+                DBG ("Sample has changed since the state was saved: " << zone.file.getFullPathName());
+            }
+
+            BigInteger range;
+            range.setRange (zone.loKey, zone.hiKey - zone.loKey + 1, true);
+
+            // The sound streams everything past the cached preload head from disk
+            batch.sounds[i] = new StreamingSamplerSound (sample, formatManager, range, zone.rootKey, 0.0, 0.1);
+        }
+
+        if (--batch.numRunning == 0) {
+            batch.finished.signal();
+        }
+
+        return jobHasFinished;
+    }
+
+private:
+    bool isCancelled() const
+    {
+        return batch.cancelled || shouldExit();
+    }
+
+    // Restores only. A zone's file that's gone missing is looked for next to
+    // the source, in case the instrument moved, and taken if its fingerprint
+    // is the one that was saved. Files where they should be are left to the
+    // cache, which fingerprints them only if it has to read them anyway.
+    void findMovedSample (juce::File& file, juce::uint64 expected) const
+    {
+        if (file.existsAsFile()) {
+            return;
+        }
+
+        auto moved = batch.sourceFolder.getChildFile (file.getFileName());
+
+        if (moved.existsAsFile() && SamplerState::fingerprint (moved) == expected) {
+            file = moved;
+        }
+    }
+
+    juce::AudioFormatManager& formatManager;
+    SampleCache& cache;
+    Batch& batch;
+};
+
+//==============================================================================
+class SampleLoader::LoadJob  : public juce::ThreadPoolJob
+{
+public:
+    LoadJob (SampleLoader& o, const juce::File& f, CompactSampleBuffer::Format s,
+             const SamplePreprocessor::Settings& p, int request,
+             std::vector<ZoneMap::Description> z = {}, std::vector<juce::uint64> fp = {})
+        : juce::ThreadPoolJob ("Sample Load"), owner (o), file (f), storage (s), preprocessing (p), requestId (request),
+          restoredZones (std::move (z)), restoredFingerprints (std::move (fp))
+    {
+    }
+
+    JobStatus runJob() override
+    {
+        using namespace juce;
+        // Restored zones are used as saved, only new loads go through the importer
+        auto zones = restoredZones.empty() ? ZoneImporter::import (file, owner.mFormatManager) : std::move (restoredZones);
+        auto fingerprints = std::move (restoredFingerprints);
+        fingerprints.resize (zones.size());
+
+        if (zones.empty() || isStale()) {
+            return jobHasFinished;
+        }
+
+        // Whatever earlier loads, in any instance, left behind unused can go now
+        owner.mCache->purgeUnused();
+
+        std::vector<ReferenceCountedObjectPtr<StreamingSamplerSound>> sounds (zones.size());
+
+        if (!decodeZones (zones, sounds, fingerprints)) {
+            return jobHasFinished;
+        }
+
+        auto result = std::make_unique<LoadedSample>();
+        result->file = file;
+        result->storage = storage;
+        result->peaks = owner.mCache->getPeaks (zones.front().file, owner.mFormatManager);
+        result->zoneMap = new ZoneMap (zones, sounds);
+        result->zones = std::move (zones);
+        result->fingerprints = std::move (fingerprints);
+
+        {
+            const ScopedLock sl (owner.mResultLock);
+
+            if (isStale() || result->zoneMap->getNumZones() == 0) {
+                return jobHasFinished;
+            }
+
+            owner.mResult = std::move (result);
+        }
+
+        owner.triggerAsyncUpdate();
+        return jobHasFinished;
+    }
+
+private:
+    bool isStale() const
+    {
+        return shouldExit() || owner.mLatestRequest.load() != requestId;
+    }
+
+    bool decodeZones (std::vector<ZoneMap::Description>& zones,
+                      std::vector<juce::ReferenceCountedObjectPtr<StreamingSamplerSound>>& sounds,
+                      std::vector<juce::uint64>& fingerprints)
+    {
+        // Large instruments get shorter preload heads rather than running out of
+        // memory. Compact storage fits longer heads in the same memory.
+        auto bytesPerFrame = CompactSampleBuffer::getTypicalBytesPerFrame (storage);
+        auto framesPerZone = static_cast<size_t> (static_cast<double> (preloadBudgetBytes) / (bytesPerFrame * static_cast<double> (zones.size())));
+        auto maxFrames = static_cast<size_t> (StreamingSamplerSound::preloadFrames * 2 * sizeof (float) / bytesPerFrame);
+        auto numPreloadFrames = static_cast<int> (juce::jlimit<size_t> (minPreloadFrames, maxFrames, framesPerZone));
+
+        auto sourceFolder = file.isDirectory() ? file : file.getParentDirectory();
+        DecodeJob::Batch batch { zones, sounds, fingerprints, sourceFolder, numPreloadFrames, storage, preprocessing };
+        auto numJobs = juce::jmin (static_cast<int> (zones.size()), owner.mDecodePool->getNumThreads());
+        batch.numRunning = numJobs;
+
+        for (int i = 0; i < numJobs; ++i) {
+            owner.mDecodePool->addJob (new DecodeJob (owner.mFormatManager, *owner.mCache, batch), true);
+        }
+
+        // The batch lives on this stack, so always wait for every decode job to let go of it
+        while (batch.numRunning > 0) {
+            if (isStale()) {
+                batch.cancelled = true;
+            }
+
+            batch.finished.wait (20);
+        }
+
+        return !isStale();
+    }
+
+    static constexpr size_t minPreloadFrames { 4096 };
+
+    SampleLoader& owner;
+    juce::File file;
+    CompactSampleBuffer::Format storage;
+    SamplePreprocessor::Settings preprocessing;
+    int requestId;
+    std::vector<ZoneMap::Description> restoredZones;
+    std::vector<juce::uint64> restoredFingerprints;
+};
+
+//==============================================================================
+SampleLoader::SampleLoader (juce::AudioFormatManager& formatManager)
+    : mFormatManager (formatManager)
+{
+}
+
+SampleLoader::~SampleLoader()
+{
+    // Stopping the load job cancels its batch, and it always waits for its
+    // decode jobs to let go of the batch and of this loader. So this waits as
+    // long as that takes, a timeout would leave them running on the shared
+    // pool with both gone. Other instances' jobs there are left alone.
+    mPool.removeAllJobs (true, -1);
+    cancelPendingUpdate();
+}
+
+void SampleLoader::loadAsync (const juce::File& file, CompactSampleBuffer::Format storage,
+                              const SamplePreprocessor::Settings& preprocessing)
+{
+    auto request = ++mLatestRequest;
+
+    // Ask any running job to bail out, without waiting for it here
+    mPool.removeAllJobs (true, 0);
+    mPool.addJob (new LoadJob (*this, file, storage, preprocessing, request), true);
+}
+
+void SampleLoader::restoreAsync (const juce::File& source, std::vector<ZoneMap::Description> zones,
+                                 std::vector<juce::uint64> fingerprints, CompactSampleBuffer::Format storage,
+                                 const SamplePreprocessor::Settings& preprocessing)
+{
+    auto request = ++mLatestRequest;
+
+    mPool.removeAllJobs (true, 0);
+    mPool.addJob (new LoadJob (*this, source, storage, preprocessing, request, std::move (zones), std::move (fingerprints)), true);
+}
+
+void SampleLoader::handleAsyncUpdate()
+{
+    std::unique_ptr<LoadedSample> result;
+
+    {
+        const juce::ScopedLock sl (mResultLock);
+        result = std::move (mResult);
+    }
+
+    if (result != nullptr && onLoaded != nullptr) {
+        onLoaded (std::move (result));
+    }
+}
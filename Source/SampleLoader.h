@@ -0,0 +1,94 @@
+/*
+  ==============================================================================
+
+    SampleLoader.h
+    Created: 17 Oct 2026 11:34:08am
+    Author:  Adam Chung
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "StreamingSamplerSound.h"
+#include "ZoneMap.h"
+#include "SampleCache.h"
+
+//==============================================================================
+/*
+    Builds instruments on a background thread so loading never runs alongside
+    processBlock. A file, SFZ or folder is read into zone descriptions by
+    ZoneImporter, then every zone's sound is built in parallel on a pool of
+    decode threads. Decoded data comes from the process-wide SampleCache, so a
+    file another instance already loaded isn't read again.
+
+    The decode threads are shared the same way, by every instance in the
+    process, so a session full of samplers doesn't start a pool per instance.
+    Each load only waits for its own zones.
+
+    Only the latest request counts: starting a new load cancels whatever was
+    in flight, and results of superseded loads are thrown away.
+*/
+class SampleLoader  : private juce::AsyncUpdater
+{
+public:
+    struct LoadedSample
+    {
+        juce::File file;
+        ZoneMap::Ptr zoneMap;
+
+        // The first zone's sample, for the editor to draw
+        SampleCache::Peaks::Ptr peaks;
+
+        // What was loaded, for saving with the plugin state
+        CompactSampleBuffer::Format storage { CompactSampleBuffer::Format::float32 };
+        std::vector<ZoneMap::Description> zones;
+        std::vector<juce::uint64> fingerprints;
+    };
+
+    SampleLoader (juce::AudioFormatManager& formatManager);
+    ~SampleLoader() override;
+
+    // file can be an audio file, an SFZ file or a folder of samples. Preload
+    // heads are kept in the given format, compact ones fit more in the budget.
+    // Every sample is run through the SamplePreprocessor on the decode threads.
+    void loadAsync (const juce::File& file, CompactSampleBuffer::Format storage,
+                    const SamplePreprocessor::Settings& preprocessing);
+
+    // Loads zones saved with the plugin state, skipping the importer. Files that
+    // moved are looked for next to source by their fingerprints.
+    void restoreAsync (const juce::File& source, std::vector<ZoneMap::Description> zones,
+                       std::vector<juce::uint64> fingerprints, CompactSampleBuffer::Format storage,
+                       const SamplePreprocessor::Settings& preprocessing);
+
+    // Preload heads of an instrument share this much memory between them
+    static constexpr size_t preloadBudgetBytes { 256 * 1024 * 1024 };
+
+    // Called on the message thread with the finished sample
+    std::function<void (std::unique_ptr<LoadedSample>)> onLoaded;
+
+private:
+    class LoadJob;
+    class DecodeJob;
+
+    // One decode thread per core but one, for every instance in the process
+    struct DecodePool  : public juce::ThreadPool
+    {
+        DecodePool() : juce::ThreadPool (juce::jmax (1, juce::SystemStats::getNumCpus() - 1)) {}
+    };
+
+    void handleAsyncUpdate() override;
+
+    juce::AudioFormatManager& mFormatManager;
+    juce::SharedResourcePointer<SampleCache> mCache;
+    // Declared first so it outlives the load job waiting on it
+    juce::SharedResourcePointer<DecodePool> mDecodePool;
+    juce::ThreadPool mPool { 1 };
+
+    juce::CriticalSection mResultLock;
+    std::unique_ptr<LoadedSample> mResult;
+    std::atomic<int> mLatestRequest { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SampleLoader)
+};
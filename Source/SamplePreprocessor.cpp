@@ -0,0 +1,508 @@
+/*
+  ==============================================================================
+
+    SamplePreprocessor.cpp
+    Created: 18 Oct 2026 1:27:44am
+    Author:  Adam Chung
+
+  ==============================================================================
+*/
+
+#include "SamplePreprocessor.h"
+#include "SamplerState.h"
+#include <complex>
+
+namespace
+{
+    using Result = SamplePreprocessor::Result;
+
+    constexpr int readBlockFrames { 65536 };
+    constexpr int tileFrames { 512 };                 // readBlockFrames is a multiple of it
+    constexpr int trimSearchFrames { 1024 };          // how far a trimmed end may move to reach a zero crossing
+    constexpr int loopSnapFrames { 256 };             // same for the loop points, kept short to stay in phase
+    constexpr int cacheMagic { 0x50505342 };          // "BSPP"
+    constexpr int cacheVersion { 1 };
+    constexpr juce::int64 cacheEntryBytes { 2 * 4 + 4 * 8 + 4 };
+
+    //==============================================================================
+    // Transposed direct form II, in double as the high-pass sits very low at high rates
+    struct Biquad
+    {
+        double b0 { 1.0 }, b1 { 0.0 }, b2 { 0.0 }, a1 { 0.0 }, a2 { 0.0 };
+        double z1 { 0.0 }, z2 { 0.0 };
+
+        double process (double x)
+        {
+            auto y = b0 * x + z1;
+            z1 = b1 * x - a1 * y + z2;
+            z2 = b2 * x - a2 * y;
+            return y;
+        }
+    };
+
+    // The two stages of the BS.1770 K-weighting filter, designed for any sample
+    // rate the way libebur128 does it, which gives the standard's own
+    // coefficients at 48 kHz
+    Biquad makeKWeightingShelf (double sampleRate)
+    {
+        constexpr double gainDb = 3.999843853973347, frequency = 1681.974450955533, q = 0.7071752369554196;
+
+        auto k = std::tan (juce::MathConstants<double>::pi * frequency / sampleRate);
+        auto vh = std::pow (10.0, gainDb / 20.0);
+        auto vb = std::pow (vh, 0.4996667741545416);
+        auto a0 = 1.0 + k / q + k * k;
+
+        Biquad shelf;
+        shelf.b0 = (vh + vb * k / q + k * k) / a0;
+        shelf.b1 = 2.0 * (k * k - vh) / a0;
+        shelf.b2 = (vh - vb * k / q + k * k) / a0;
+        shelf.a1 = 2.0 * (k * k - 1.0) / a0;
+        shelf.a2 = (1.0 - k / q + k * k) / a0;
+        return shelf;
+    }
+
+    Biquad makeKWeightingHighPass (double sampleRate)
+    {
+        constexpr double frequency = 38.13547087602444, q = 0.5003270373238773;
+
+        auto k = std::tan (juce::MathConstants<double>::pi * frequency / sampleRate);
+        auto a0 = 1.0 + k / q + k * k;
+
+        Biquad highPass;
+        highPass.b0 = 1.0;
+        highPass.b1 = -2.0;
+        highPass.b2 = 1.0;
+        highPass.a1 = 2.0 * (k * k - 1.0) / a0;
+        highPass.a2 = (1.0 - k / q + k * k) / a0;
+        return highPass;
+    }
+
+    // BS.1770-4: 400 ms blocks overlapping by 75%, gated at -70 LUFS and then at
+    // 10 LU below the loudness of what passed. Steps are 100 ms mean squares.
+    double getIntegratedLoudness (const std::vector<double>& stepEnergies, double wholeFileEnergy)
+    {
+        auto toLufs = [] (double meanSquare) { return -0.691 + 10.0 * std::log10 (meanSquare); };
+
+        std::vector<double> blocks;
+
+        for (size_t i = 3; i < stepEnergies.size(); ++i) {
+            blocks.push_back ((stepEnergies[i - 3] + stepEnergies[i - 2] + stepEnergies[i - 1] + stepEnergies[i]) / 4.0);
+        }
+
+        // Shorter than one block, the whole file is the block
+        if (blocks.empty()) {
+            blocks.push_back (wholeFileEnergy);
+        }
+
+        auto getGatedMean = [&] (double gateLufs) {
+            double sum = 0.0;
+            int numPassed = 0;
+
+            for (auto block : blocks) {
+                if (block > 0.0 && toLufs (block) > gateLufs) {
+                    sum += block;
+                    ++numPassed;
+                }
+            }
+
+            return numPassed > 0 ? sum / numPassed : 0.0;
+        };
+
+        auto absoluteGated = getGatedMean (-70.0);
+
+        if (absoluteGated <= 0.0) {
+            return -std::numeric_limits<double>::infinity();
+        }
+
+        return toLufs (getGatedMean (toLufs (absoluteGated) - 10.0));
+    }
+
+    //==============================================================================
+    juce::AudioBuffer<float> readFrames (juce::AudioFormatReader& reader, juce::int64 start, int numFrames)
+    {
+        // Always stereo, mono files come back with the channel doubled
+        juce::AudioBuffer<float> buffer (2, numFrames);
+        buffer.clear();
+        reader.read (&buffer, 0, numFrames, start, true, true);
+        return buffer;
+    }
+
+    std::vector<float> mixToMono (const juce::AudioBuffer<float>& buffer)
+    {
+        auto numFrames = buffer.getNumSamples();
+        std::vector<float> mono (static_cast<size_t> (numFrames));
+
+        juce::FloatVectorOperations::add (mono.data(), buffer.getReadPointer (0), buffer.getReadPointer (1), numFrames);
+        juce::FloatVectorOperations::multiply (mono.data(), 0.5f, numFrames);
+        return mono;
+    }
+
+    bool isLoud (const juce::AudioBuffer<float>& buffer, int frame, float threshold)
+    {
+        return std::abs (buffer.getSample (0, frame)) >= threshold || std::abs (buffer.getSample (1, frame)) >= threshold;
+    }
+
+    bool crossesZero (const std::vector<float>& mono, int frame)
+    {
+        return mono[static_cast<size_t> (frame)] == 0.0f
+            || (mono[static_cast<size_t> (frame - 1)] < 0.0f) != (mono[static_cast<size_t> (frame)] < 0.0f);
+    }
+
+    bool risesThroughZero (const std::vector<float>& mono, int frame)
+    {
+        return mono[static_cast<size_t> (frame - 1)] < 0.0f && mono[static_cast<size_t> (frame)] >= 0.0f;
+    }
+
+    // Nearest frame to the given one, within maxDistance, where the signal rises
+    // through zero. The frame itself if there isn't one.
+    int findRisingZeroCrossing (const std::vector<float>& mono, int frame, int maxDistance, int lastFrame)
+    {
+        for (int distance = 0; distance <= maxDistance; ++distance) {
+            for (auto candidate : { frame - distance, frame + distance }) {
+                if (candidate > 0 && candidate <= lastFrame && risesThroughZero (mono, candidate)) {
+                    return candidate;
+                }
+            }
+        }
+
+        return frame;
+    }
+
+    //==============================================================================
+    // Cuts the silence either side of what's above threshold, tilePeaks being the
+    // peak of every tileFrames of the file
+    void trimSilence (juce::AudioFormatReader& reader, const std::vector<float>& tilePeaks, float threshold, Result& result)
+    {
+        auto isLoudTile = [threshold] (float peak) { return peak >= threshold; };
+        auto firstTile = static_cast<juce::int64> (std::find_if (tilePeaks.begin(), tilePeaks.end(), isLoudTile) - tilePeaks.begin());
+        auto lastTile = static_cast<juce::int64> (tilePeaks.rend() - std::find_if (tilePeaks.rbegin(), tilePeaks.rend(), isLoudTile)) - 1;
+        auto fileLength = reader.lengthInSamples;
+
+        // Back from the first loud frame to where the signal last crossed zero
+        auto leadIn = juce::jmin<juce::int64> (firstTile * tileFrames, trimSearchFrames);
+        auto headStart = firstTile * tileFrames - leadIn;
+        auto head = readFrames (reader, headStart, static_cast<int> (juce::jmin<juce::int64> (fileLength - headStart, leadIn + tileFrames)));
+        auto headMono = mixToMono (head);
+        auto first = static_cast<int> (leadIn);
+
+        while (first < head.getNumSamples() - 1 && !isLoud (head, first, threshold)) {
+            ++first;
+        }
+
+        while (first > 0 && !crossesZero (headMono, first)) {
+            --first;
+        }
+
+        // And on from the last loud frame to where it next crosses zero
+        auto tailStart = lastTile * tileFrames;
+        auto tail = readFrames (reader, tailStart, static_cast<int> (juce::jmin<juce::int64> (fileLength - tailStart, tileFrames + trimSearchFrames)));
+        auto tailMono = mixToMono (tail);
+        auto last = juce::jmin (tileFrames, tail.getNumSamples()) - 1;
+
+        while (last > 0 && !isLoud (tail, last, threshold)) {
+            --last;
+        }
+
+        while (last < tail.getNumSamples() - 1 && !crossesZero (tailMono, last + 1)) {
+            ++last;
+        }
+
+        result.start = headStart + first;
+        result.length = juce::jmax<juce::int64> (1, tailStart + last + 1 - result.start);
+    }
+
+    // Looks for the stretch that best matches the loopMatchFrames before the loop
+    // end, the loop then starts straight after it
+    void findLoop (juce::AudioFormatReader& reader, Result& result)
+    {
+        using namespace SamplePreprocessor;
+
+        // The last eighth is left alone, that's usually the release
+        auto loopEnd = result.length - result.length / 8;
+        auto minLoopFrames = juce::jmax (loopMatchFrames, juce::roundToInt (reader.sampleRate * 0.1));
+        auto searchFrames = static_cast<int> (juce::jmin<juce::int64> (loopEnd, juce::int64 { 1 } << loopSearchOrder));
+
+        if (searchFrames < 2 * loopMatchFrames + minLoopFrames) {
+            return;
+        }
+
+        auto regionStart = loopEnd - searchFrames;
+        auto mono = mixToMono (readFrames (reader, result.start + regionStart, searchFrames));
+        auto templateStart = searchFrames - loopMatchFrames;
+        auto numLags = templateStart - minLoopFrames + 1;
+
+        // Correlation against every lag at once, as the inverse transform of
+        // X conj (T), zero padded so it doesn't wrap round
+        int order = 1;
+
+        while ((1 << order) < searchFrames + loopMatchFrames) {
+            ++order;
+        }
+
+        auto size = 1 << order;
+        juce::dsp::FFT fft (order);
+        std::vector<float> signal (static_cast<size_t> (2 * size)), pattern (static_cast<size_t> (2 * size));
+
+        std::copy (mono.begin(), mono.end(), signal.begin());
+        std::copy (mono.begin() + templateStart, mono.end(), pattern.begin());
+
+        fft.performRealOnlyForwardTransform (signal.data(), true);
+        fft.performRealOnlyForwardTransform (pattern.data(), true);
+
+        auto* x = reinterpret_cast<std::complex<float>*> (signal.data());
+        auto* t = reinterpret_cast<const std::complex<float>*> (pattern.data());
+
+        for (int bin = 0; bin <= size / 2; ++bin) {
+            x[bin] *= std::conj (t[bin]);
+        }
+
+        fft.performRealOnlyInverseTransform (signal.data());
+
+        // Normalised by both windows' energy, taken from a running sum of squares
+        std::vector<double> energy (static_cast<size_t> (searchFrames) + 1);
+
+        for (int i = 0; i < searchFrames; ++i) {
+            auto sample = static_cast<double> (mono[static_cast<size_t> (i)]);
+            energy[static_cast<size_t> (i) + 1] = energy[static_cast<size_t> (i)] + sample * sample;
+        }
+
+        auto templateEnergy = energy[static_cast<size_t> (searchFrames)] - energy[static_cast<size_t> (templateStart)];
+
+        if (templateEnergy <= 0.0) {
+            return;
+        }
+
+        int bestLag = -1;
+        double bestCorrelation = minLoopCorrelation;
+
+        for (int lag = 0; lag < numLags; ++lag) {
+            auto windowEnergy = energy[static_cast<size_t> (lag + loopMatchFrames)] - energy[static_cast<size_t> (lag)];
+
+            if (windowEnergy <= 0.0) {
+                continue;
+            }
+
+            auto correlation = signal[static_cast<size_t> (lag)] / std::sqrt (windowEnergy * templateEnergy);
+
+            if (correlation > bestCorrelation) {
+                bestCorrelation = correlation;
+                bestLag = lag;
+            }
+        }
+
+        if (bestLag < 0) {
+            return;
+        }
+
+        // Both ends on rising zero crossings, the start looked for where the end's
+        // move puts it so the two stay in phase
+        auto end = searchFrames;
+
+        for (int frame = searchFrames - 1; frame > searchFrames - loopSnapFrames; --frame) {
+            if (risesThroughZero (mono, frame)) {
+                end = frame;
+                break;
+            }
+        }
+
+        auto start = findRisingZeroCrossing (mono, bestLag + loopMatchFrames - (searchFrames - end), loopSnapFrames, end - minLoopFrames);
+
+        result.loopStart = regionStart + start;
+        result.loopEnd = regionStart + end;
+    }
+
+    //==============================================================================
+    juce::File getCacheFile (juce::uint64 fingerprint, const SamplePreprocessor::Settings& settings)
+    {
+        return juce::File::getSpecialLocation (juce::File::userApplicationDataDirectory)
+                   .getChildFile ("BasicSampler")
+                   .getChildFile ("Preprocessing")
+                   .getChildFile (juce::String::toHexString (static_cast<juce::int64> (fingerprint)) + "-" + settings.toString() + ".bin");
+    }
+
+    bool readCached (const juce::File& file, juce::int64 fileLength, Result& result)
+    {
+        juce::FileInputStream in (file);
+
+        if (!in.openedOk() || in.getTotalLength() != cacheEntryBytes
+            || in.readInt() != cacheMagic || in.readInt() != cacheVersion) {
+            return false;
+        }
+
+        Result cached;
+        cached.start = in.readInt64();
+        cached.length = in.readInt64();
+        cached.gain = in.readFloat();
+        cached.loopStart = in.readInt64();
+        cached.loopEnd = in.readInt64();
+
+        // Anything that doesn't fit the file is stale or broken, and analysed again
+        if (cached.start < 0 || cached.length <= 0 || cached.start + cached.length > fileLength
+            || !(cached.gain > 0.0f) || cached.loopEnd > cached.length) {
+            return false;
+        }
+
+        result = cached;
+        return true;
+    }
+
+    void writeCached (const juce::File& file, const Result& result)
+    {
+        if (!file.getParentDirectory().createDirectory()) {
+            return;
+        }
+
+        // Written aside and moved into place, so other instances never read half an entry
+        juce::TemporaryFile temp (file);
+
+        {
+            juce::FileOutputStream out (temp.getFile());
+
+            if (!out.openedOk()) {
+                return;
+            }
+
+            out.writeInt (cacheMagic);
+            out.writeInt (cacheVersion);
+            out.writeInt64 (result.start);
+            out.writeInt64 (result.length);
+            out.writeFloat (result.gain);
+            out.writeInt64 (result.loopStart);
+            out.writeInt64 (result.loopEnd);
+        }
+
+        temp.overwriteTargetFileWithTemporary();
+    }
+}
+
+//==============================================================================
+juce::StringArray SamplePreprocessor::getNormalisationNames()
+{
+    return { "Off", "Peak", "Loudness" };
+}
+
+juce::String SamplePreprocessor::Settings::toString() const
+{
+    return "t" + juce::String (trim ? 1 : 0)
+         + "n" + juce::String (static_cast<int> (normalisation))
+         + "l" + juce::String (findLoop ? 1 : 0);
+}
+
+SamplePreprocessor::Result SamplePreprocessor::process (const juce::File& file, juce::AudioFormatReader& reader, const Settings& settings)
+{
+    if (settings.isNeutral()) {
+        return analyse (reader, settings);
+    }
+
+    // Keyed by content, so a cached result follows the file if it moves
+    auto fingerprint = SamplerState::fingerprint (file);
+    auto cacheFile = getCacheFile (fingerprint, settings);
+    Result result;
+
+    if (fingerprint != 0 && readCached (cacheFile, reader.lengthInSamples, result)) {
+        return result;
+    }
+
+    result = analyse (reader, settings);
+
+    if (fingerprint != 0) {
+        writeCached (cacheFile, result);
+    }
+
+    return result;
+}
+
+SamplePreprocessor::Result SamplePreprocessor::analyse (juce::AudioFormatReader& reader, const Settings& settings)
+{
+    Result result;
+    result.length = reader.lengthInSamples;
+
+    if (result.length <= 0 || settings.isNeutral()) {
+        return result;
+    }
+
+    // One pass over the file for the peak of every tile and, when it's needed,
+    // the K-weighted energy of every 100 ms step
+    std::vector<float> tilePeaks (static_cast<size_t> ((result.length + tileFrames - 1) / tileFrames));
+    std::vector<double> stepEnergies;
+
+    auto measureLoudness = settings.normalisation == Normalisation::loudness && reader.sampleRate > 0.0;
+    auto numChannels = juce::jlimit (1, 2, static_cast<int> (reader.numChannels));
+    auto stepFrames = juce::jmax (1, juce::roundToInt (reader.sampleRate * 0.1));
+    double stepEnergy = 0.0, totalEnergy = 0.0;
+    int stepPosition = 0;
+
+    std::array<std::array<Biquad, 2>, 2> kWeighting;
+
+    for (auto& stages : kWeighting) {
+        stages = { makeKWeightingShelf (reader.sampleRate), makeKWeightingHighPass (reader.sampleRate) };
+    }
+
+    juce::AudioBuffer<float> block (2, readBlockFrames);
+
+    for (juce::int64 position = 0; position < result.length; position += readBlockFrames) {
+        auto numInBlock = static_cast<int> (juce::jmin<juce::int64> (readBlockFrames, result.length - position));
+        reader.read (&block, 0, numInBlock, position, true, true);
+
+        for (int offset = 0; offset < numInBlock; offset += tileFrames) {
+            auto numInTile = juce::jmin (tileFrames, numInBlock - offset);
+            auto& peak = tilePeaks[static_cast<size_t> ((position + offset) / tileFrames)];
+
+            for (int ch = 0; ch < 2; ++ch) {
+                auto range = juce::FloatVectorOperations::findMinAndMax (block.getReadPointer (ch, offset), numInTile);
+                peak = juce::jmax (peak, -range.getStart(), range.getEnd());
+            }
+        }
+
+        if (!measureLoudness) {
+            continue;
+        }
+
+        for (int i = 0; i < numInBlock; ++i) {
+            for (int ch = 0; ch < numChannels; ++ch) {
+                auto& stages = kWeighting[static_cast<size_t> (ch)];
+                auto weighted = stages[1].process (stages[0].process (block.getSample (ch, i)));
+                stepEnergy += weighted * weighted;
+            }
+
+            if (++stepPosition == stepFrames) {
+                stepEnergies.push_back (stepEnergy / stepFrames);
+                totalEnergy += stepEnergy;
+                stepEnergy = 0.0;
+                stepPosition = 0;
+            }
+        }
+    }
+
+    auto peak = tilePeaks.empty() ? 0.0f : *std::max_element (tilePeaks.begin(), tilePeaks.end());
+
+    // Nothing to measure in a silent file, it's played as it is
+    if (peak <= 0.0f) {
+        return result;
+    }
+
+    if (settings.trim) {
+        trimSilence (reader, tilePeaks, peak * juce::Decibels::decibelsToGain (trimThresholdDb), result);
+    }
+
+    // Loudness normalisation never pushes the peak past the peak target either
+    auto peakGain = juce::Decibels::decibelsToGain (peakTargetDb) / peak;
+
+    if (settings.normalisation == Normalisation::peak) {
+        result.gain = peakGain;
+    } else if (measureLoudness) {
+        auto lufs = getIntegratedLoudness (stepEnergies, (totalEnergy + stepEnergy) / static_cast<double> (reader.lengthInSamples));
+
+        if (std::isfinite (lufs)) {
+            result.gain = juce::jmin (peakGain, juce::Decibels::decibelsToGain (loudnessTargetLufs - static_cast<float> (lufs)));
+        }
+    }
+
+    result.gain = juce::jmin (result.gain, juce::Decibels::decibelsToGain (maxGainDb));
+
+    if (settings.findLoop) {
+        findLoop (reader, result);
+    }
+
+    return result;
+}
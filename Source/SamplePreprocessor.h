@@ -0,0 +1,81 @@
+/*
+  ==============================================================================
+
+    SamplePreprocessor.h
+    Created: 18 Oct 2026 1:27:44am
+    Author:  Adam Chung
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/*
+    Works out at load time how a sample should be played:
+
+      trim        where the sound starts and ends once the silence either side
+                  is cut, both ends snapped to zero crossings
+      normalise   a gain bringing the sample to a peak level, or to a loudness
+                  measured as gated BS.1770 integrated loudness (LUFS)
+      loop        a sustain loop whose end runs on seamlessly into its start,
+                  found by FFT cross-correlation and snapped to rising zero
+                  crossings
+
+    The file is read a block at a time, only the loop search keeps a stretch of
+    it in memory. Results go in a small file per sample and settings under the
+    user's application data folder, so a sample is only ever analysed once for
+    each combination of settings, until it changes.
+*/
+namespace SamplePreprocessor
+{
+    enum class Normalisation { off, peak, loudness };
+
+    juce::StringArray getNormalisationNames();
+
+    struct Settings
+    {
+        bool trim { false };
+        Normalisation normalisation { Normalisation::off };
+        bool findLoop { false };
+
+        bool isNeutral() const { return !trim && normalisation == Normalisation::off && !findLoop; }
+
+        // Short and filename safe, for cache keys
+        juce::String toString() const;
+    };
+
+    struct Result
+    {
+        juce::int64 start { 0 };        // first frame of the file to play
+        juce::int64 length { 0 };       // frames to play from there
+        float gain { 1.0f };
+
+        // Relative to start, -1 if the sample doesn't loop
+        juce::int64 loopStart { -1 };
+        juce::int64 loopEnd { -1 };
+
+        bool hasLoop() const { return loopStart >= 0 && loopEnd > loopStart; }
+    };
+
+    // Any thread but the audio thread. Returns the cached result for the file if
+    // there is one, otherwise analyses it through reader and caches that.
+    // Neutral settings play the whole file as it is, without reading anything.
+    Result process (const juce::File& file, juce::AudioFormatReader& reader, const Settings& settings);
+
+    // The analysis itself, uncached
+    Result analyse (juce::AudioFormatReader& reader, const Settings& settings);
+
+    constexpr float trimThresholdDb { -60.0f };     // relative to the sample's peak
+    constexpr float peakTargetDb { -1.0f };
+    constexpr float loudnessTargetLufs { -18.0f };
+    constexpr float maxGainDb { 24.0f };
+
+    // The loop search looks at most 2^loopSearchOrder frames back from the loop
+    // end, for the stretch that best matches the loopMatchFrames leading up to it
+    constexpr int loopSearchOrder { 18 };
+    constexpr int loopMatchFrames { 2048 };
+    constexpr float minLoopCorrelation { 0.9f };
+}
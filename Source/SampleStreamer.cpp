@@ -0,0 +1,72 @@
+/*
+  ==============================================================================
+
+    SampleStreamer.cpp
+    Created: 17 Oct 2026 9:41:27am
+    Author:  Adam Chung
+
+  ==============================================================================
+*/
+
+#include "SampleStreamer.h"
+
+//==============================================================================
+SampleStreamer::SampleStreamer()
+{
+    mThread.addTimeSliceClient (this);
+    mThread.startThread (juce::Thread::Priority::high);
+}
+
+SampleStreamer::~SampleStreamer()
+{
+    mThread.removeTimeSliceClient (this);
+    mThread.stopThread (1000);
+}
+
+void SampleStreamer::addVoice (StreamingSamplerVoice* voice)
+{
+    const juce::ScopedLock sl (mLock);
+
+    if (mVoices.addIfNotAlreadyThere (voice)) {
+        voice->setUnderrunCounter (&mNumUnderruns);
+    }
+}
+
+void SampleStreamer::removeAllVoices()
+{
+    const juce::ScopedLock sl (mLock);
+
+    for (auto* voice : mVoices) {
+        voice->setUnderrunCounter (nullptr);
+    }
+
+    mVoices.clear();
+}
+
+void SampleStreamer::addSound (StreamingSamplerSound* sound)
+{
+    const juce::ScopedLock sl (mLock);
+    mSounds.add (sound);
+}
+
+void SampleStreamer::removeSound (StreamingSamplerSound* sound)
+{
+    const juce::ScopedLock sl (mLock);
+    mSounds.removeValue (sound);
+}
+
+int SampleStreamer::useTimeSlice()
+{
+    const juce::ScopedLock sl (mLock);
+    bool didWork = false;
+    bool isOffline = false;
+
+    for (auto* voice : mVoices) {
+        didWork = voice->fillStream (mSounds) || didWork;
+        isOffline = isOffline || voice->isOffline();
+    }
+
+    // Come straight back while any voice is still behind, otherwise poll gently,
+    // or not so gently while bouncing, when voices wait on the ring
+    return didWork ? 0 : (isOffline ? 1 : 5);
+}
@@ -0,0 +1,54 @@
+/*
+  ==============================================================================
+
+    SampleStreamer.h
+    Created: 17 Oct 2026 9:41:27am
+    Author:  Adam Chung
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "StreamingSamplerSound.h"
+#include "StreamingSamplerVoice.h"
+
+//==============================================================================
+/*
+    Background disk reader for the streaming voices. Owns the thread that keeps
+    every voice's ring buffer filled ahead of its playhead.
+
+    Sounds have to be registered before voices can stream from them. The
+    owner must call removeSound() before a sound is deleted; once that returns
+    the streamer will never touch it again.
+*/
+class SampleStreamer  : private juce::TimeSliceClient
+{
+public:
+    SampleStreamer();
+    ~SampleStreamer() override;
+
+    void addVoice (StreamingSamplerVoice* voice);
+    void removeAllVoices();
+
+    void addSound (StreamingSamplerSound* sound);
+    void removeSound (StreamingSamplerSound* sound);
+
+    // Any thread, the audio thread included: one relaxed load, no lock
+    int getNumUnderruns() const { return mNumUnderruns.load (std::memory_order_relaxed); }
+
+private:
+    int useTimeSlice() override;
+
+    juce::TimeSliceThread mThread { "Sample Streamer" };
+
+    juce::CriticalSection mLock;
+    juce::Array<StreamingSamplerVoice*> mVoices;
+    juce::SortedSet<StreamingSamplerSound*> mSounds;   // sorted, voices look their sound up every slice
+
+    // Every voice's underruns, counted by the voices themselves
+    std::atomic<int> mNumUnderruns { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SampleStreamer)
+};
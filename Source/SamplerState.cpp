@@ -0,0 +1,155 @@
+/*
+  ==============================================================================
+
+    SamplerState.cpp
+    Created: 17 Oct 2026 11:52:16pm
+    Author:  Adam Chung
+
+  ==============================================================================
+*/
+
+#include "SamplerState.h"
+
+//==============================================================================
+void SamplerState::write (const Snapshot& snapshot, juce::MemoryBlock& destData)
+{
+    juce::MemoryOutputStream out (destData, false);
+
+    out.writeInt (magic);
+    out.writeInt (currentVersion);
+
+    juce::MemoryBlock parameters;
+    {
+        juce::MemoryOutputStream parameterStream (parameters, false);
+        snapshot.parameters.writeToStream (parameterStream);
+    }
+
+    out.writeCompressedInt (static_cast<int> (parameters.getSize()));
+    out.write (parameters.getData(), parameters.getSize());
+
+    out.writeString (snapshot.source.getFullPathName());
+    out.writeByte (static_cast<char> (snapshot.storage));
+    out.writeCompressedInt (static_cast<int> (snapshot.zones.size()));
+
+    for (size_t i = 0; i < snapshot.zones.size(); ++i) {
+        const auto& zone = snapshot.zones[i];
+
+        out.writeString (zone.file.getFullPathName());
+        out.writeByte (static_cast<char> (zone.loKey));
+        out.writeByte (static_cast<char> (zone.hiKey));
+        out.writeByte (static_cast<char> (zone.rootKey));
+        out.writeByte (static_cast<char> (zone.loVelocity));
+        out.writeByte (static_cast<char> (zone.hiVelocity));
+        out.writeCompressedInt (zone.seqLength);
+        out.writeCompressedInt (zone.seqPosition);
+        out.writeInt64 (static_cast<juce::int64> (i < snapshot.fingerprints.size() ? snapshot.fingerprints[i] : 0));
+    }
+}
+
+bool SamplerState::read (const void* data, int sizeInBytes, Snapshot& snapshot)
+{
+    if (data == nullptr || sizeInBytes < 8) {
+        return false;
+    }
+
+    juce::MemoryInputStream in (data, static_cast<size_t> (sizeInBytes), false);
+
+    if (in.readInt() != magic) {
+        return false;
+    }
+
+    auto version = in.readInt();
+
+    if (version < 1 || version > currentVersion) {
+        return false;
+    }
+
+    auto parametersSize = in.readCompressedInt();
+
+    if (parametersSize < 0 || parametersSize > in.getNumBytesRemaining()) {
+        return false;
+    }
+
+    snapshot.parameters = juce::ValueTree::readFromData (static_cast<const char*> (data) + in.getPosition(), static_cast<size_t> (parametersSize));
+    in.skipNextBytes (parametersSize);
+
+    auto sourcePath = in.readString();
+    snapshot.source = juce::File::isAbsolutePath (sourcePath) ? juce::File (sourcePath) : juce::File();
+
+    auto storage = static_cast<int> (in.readByte());
+    snapshot.storage = juce::isPositiveAndNotGreaterThan (storage, static_cast<int> (CompactSampleBuffer::Format::compressed))
+                         ? static_cast<CompactSampleBuffer::Format> (storage)
+                         : CompactSampleBuffer::Format::float32;
+
+    // Every zone takes at least 16 bytes, anything claiming more is corrupt
+    auto numZones = in.readCompressedInt();
+
+    if (numZones < 0 || numZones > in.getNumBytesRemaining() / 16) {
+        return false;
+    }
+
+    snapshot.zones.clear();
+    snapshot.fingerprints.clear();
+    snapshot.zones.reserve (static_cast<size_t> (numZones));
+    snapshot.fingerprints.reserve (static_cast<size_t> (numZones));
+
+    for (int i = 0; i < numZones && !in.isExhausted(); ++i) {
+        ZoneMap::Description zone;
+        auto path = in.readString();
+
+        auto readByte = [&in] { return static_cast<int> (static_cast<juce::uint8> (in.readByte())); };
+        zone.loKey = juce::jlimit (0, 127, readByte());
+        zone.hiKey = juce::jlimit (zone.loKey, 127, readByte());
+        zone.rootKey = juce::jlimit (0, 127, readByte());
+        zone.loVelocity = juce::jlimit (1, 127, readByte());
+        zone.hiVelocity = juce::jlimit (zone.loVelocity, 127, readByte());
+        zone.seqLength = juce::jlimit (1, 255, in.readCompressedInt());
+        zone.seqPosition = juce::jlimit (1, zone.seqLength, in.readCompressedInt());
+        auto fingerprint = static_cast<juce::uint64> (in.readInt64());
+
+        if (juce::File::isAbsolutePath (path)) {
+            zone.file = juce::File (path);
+            snapshot.zones.push_back (zone);
+            snapshot.fingerprints.push_back (fingerprint);
+        }
+    }
+
+    return true;
+}
+
+//==============================================================================
+juce::uint64 SamplerState::fingerprint (const juce::File& file)
+{
+    constexpr int bytesPerEnd = 64 * 1024;
+
+    juce::FileInputStream in (file);
+
+    if (!in.openedOk()) {
+        return 0;
+    }
+
+    // FNV-1a
+    juce::uint64 hash = 14695981039346656037ull;
+
+    auto add = [&hash] (const juce::uint8* bytes, size_t numBytes) {
+        for (size_t i = 0; i < numBytes; ++i) {
+            hash = (hash ^ bytes[i]) * 1099511628211ull;
+        }
+    };
+
+    auto length = in.getTotalLength();
+    add (reinterpret_cast<const juce::uint8*> (&length), sizeof (length));
+
+    juce::HeapBlock<juce::uint8> buffer (bytesPerEnd);
+
+    for (auto start : { juce::int64 { 0 }, juce::jmax<juce::int64> (0, length - bytesPerEnd) }) {
+        if (!in.setPosition (start)) {
+            return 0;
+        }
+
+        auto numRead = in.read (buffer.get(), bytesPerEnd);
+        add (buffer.get(), static_cast<size_t> (juce::jmax (0, numRead)));
+    }
+
+    return hash == 0 ? 1 : hash;
+}
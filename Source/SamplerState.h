@@ -0,0 +1,56 @@
+/*
+  ==============================================================================
+
+    SamplerState.h
+    Created: 17 Oct 2026 11:52:16pm
+    Author:  Adam Chung
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "ZoneMap.h"
+#include "CompactSampleBuffer.h"
+
+//==============================================================================
+/*
+    The plugin state as saved with a project, in a small versioned binary
+    format:
+
+      magic, version
+      parameters      the APVTS tree in ValueTree's own binary form
+      source          what the user loaded: a file, an SFZ or a folder
+      storage         the CompactSampleBuffer::Format heads were kept in
+      zones           every zone's description plus a fingerprint of its file
+
+    The zones are saved as loaded, so restoring a project doesn't have to scan
+    folders or parse SFZ files again. Fingerprints let a restore find samples
+    that moved next to the source, and tell when one was edited.
+*/
+namespace SamplerState
+{
+    struct Snapshot
+    {
+        juce::ValueTree parameters;
+
+        juce::File source;   // empty if nothing was loaded
+        CompactSampleBuffer::Format storage { CompactSampleBuffer::Format::float32 };
+        std::vector<ZoneMap::Description> zones;
+        std::vector<juce::uint64> fingerprints;   // one per zone, 0 if unknown
+    };
+
+    void write (const Snapshot& snapshot, juce::MemoryBlock& destData);
+
+    // False if the data isn't a snapshot or comes from a newer version
+    bool read (const void* data, int sizeInBytes, Snapshot& snapshot);
+
+    // A hash of the file's size and the bytes at either end. The SampleCache
+    // takes it once per entry, when it first reads the file. 0 if the file
+    // can't be read.
+    juce::uint64 fingerprint (const juce::File& file);
+
+    constexpr int magic { 0x504d5342 };   // "BSMP"
+    constexpr int currentVersion { 1 };
+}
@@ -0,0 +1,660 @@
+/*
+  ==============================================================================
+
+    SamplerSynthesiser.cpp
+    Created: 17 Oct 2026 11:05:52am
+    Author:  Adam Chung
+
+  ==============================================================================
+*/
+
+#include "SamplerSynthesiser.h"
+#include "RealtimeChecker.h"
+
+//==============================================================================
+SamplerSynthesiser::SamplerSynthesiser()
+{
+    mNoteHeads.fill (-1);
+
+    // Split at every event, not just every 32 samples
+    setMinimumRenderingSubdivisionSize (1, true);
+
+    // Every block takes the synth's lock, but only prepareToPlay ever holds it
+    // otherwise, and never while the audio's running
+    RealtimeChecker::allowLock (&lock);
+}
+
+SamplerSynthesiser::~SamplerSynthesiser()
+{
+}
+
+void SamplerSynthesiser::setZoneMap (ZoneMap* newZoneMap, int crossfadeSamples)
+{
+    const juce::ScopedLock sl (lock);
+    mZoneMap = newZoneMap;
+
+    if (mZoneMap == nullptr || crossfadeSamples <= 0) {
+        return;
+    }
+
+    for (int ch = 1; ch <= 16; ++ch) {
+        for (int note = 0; note < 128; ++note) {
+            auto midiVelocity = mKeyVelocities[static_cast<size_t> (ch - 1)][static_cast<size_t> (note)];
+
+            if (midiVelocity == 0) {
+                continue;
+            }
+
+            // Only the voices still held by the key, notes held by a pedal ring on as they are
+            for (auto voice = mNoteHeads[static_cast<size_t> (note)]; voice >= 0; voice = mLinks[static_cast<size_t> (voice)].nextInNote) {
+                auto* v = mPool[static_cast<size_t> (voice)];
+
+                if (mLinks[static_cast<size_t> (voice)].list == ListId::held && v->isKeyDown() && v->isPlayingChannel (ch)) {
+                    v->startCrossfade (crossfadeSamples, false);
+                }
+            }
+
+            startZones (ch, note, static_cast<float> (midiVelocity) / 127.0f, crossfadeSamples);
+        }
+    }
+}
+
+void SamplerSynthesiser::setPolyphony (int numVoices, const std::function<StreamingSamplerVoice*()>& createVoice)
+{
+    const juce::ScopedLock sl (lock);
+
+    for (auto* voice : mPool) {
+        voice->stopNote (0.0f, false);
+    }
+
+    while (static_cast<int> (mPool.size()) < numVoices) {
+        auto* voice = createVoice();
+        addVoice (voice);
+        mPool.push_back (voice);
+    }
+
+    mPolyphony = numVoices;
+    mLinks.assign (mPool.size(), {});
+    mSounding.resize (mPool.size());
+    mFreeVoices.resize (mPool.size());
+    mHeld = {};
+    mReleased = {};
+    mNoteHeads.fill (-1);
+    mNumActive = 0;
+
+    // Lowest index on top of the stack
+    mNumFree = mPolyphony;
+    for (int i = 0; i < mPolyphony; ++i) {
+        mFreeVoices[static_cast<size_t> (i)] = mPolyphony - 1 - i;
+    }
+}
+
+void SamplerSynthesiser::prepare (int numRenderThreads, int numChannels, int maxBlockSize, bool offline)
+{
+    const juce::ScopedLock sl (lock);
+
+    // The workers render into the arena, so they go before it's laid out again
+    mRenderPool.release();
+
+    auto numScratchFrames = offline ? StreamingSamplerVoice::offlineScratchFrames : StreamingSamplerVoice::scratchFrames;
+
+    mArena.reset (mPool.size() * StreamingSamplerVoice::getArenaSize (numScratchFrames)
+                  + VoiceRenderPool::getArenaSize (numRenderThreads, numChannels, maxBlockSize));
+
+    // Voices past the polyphony too, setPolyphony() still stops them and that
+    // renders their fade-out
+    for (auto* voice : mPool) {
+        voice->prepare (mArena, numScratchFrames);
+    }
+
+    mRenderPool.prepare (numRenderThreads, numChannels, maxBlockSize, mArena);
+    setOffline (offline);
+}
+
+void SamplerSynthesiser::setOffline (bool offline)
+{
+    for (auto* voice : mPool) {
+        voice->setOffline (offline);
+    }
+
+    mRenderPool.setParallelThreshold (offline ? VoiceRenderPool::offlineParallelThreshold
+                                              : VoiceRenderPool::defaultParallelThreshold);
+}
+
+void SamplerSynthesiser::setEnvelopeParameters (const juce::ADSR::Parameters& parameters)
+{
+    const juce::ScopedLock sl (lock);
+
+    if (mZoneMap != nullptr) {
+        for (auto* sound : mZoneMap->getSounds()) {
+            sound->setEnvelopeParameters (parameters);
+        }
+    }
+}
+
+void SamplerSynthesiser::setFilterParameters (const VoiceFilter::Parameters& parameters)
+{
+    const juce::ScopedLock sl (lock);
+
+    for (auto* voice : mPool) {
+        voice->getFilter().setParameters (parameters);
+    }
+
+    mRenderPool.setFiltering (parameters.type != VoiceFilter::Type::off);
+}
+
+bool SamplerSynthesiser::isKeyDown (int midiChannel, int midiNoteNumber) const
+{
+    if (!juce::isPositiveAndNotGreaterThan (midiChannel, 16) || midiChannel == 0
+        || !juce::isPositiveAndBelow (midiNoteNumber, 128)) {
+        return false;
+    }
+
+    return mKeyVelocities[static_cast<size_t> (midiChannel - 1)][static_cast<size_t> (midiNoteNumber)] != 0;
+}
+
+void SamplerSynthesiser::setEnvelopeControllerRanges (juce::NormalisableRange<float> attack,
+                                                      juce::NormalisableRange<float> decay,
+                                                      juce::NormalisableRange<float> release)
+{
+    const juce::ScopedLock sl (lock);
+
+    mAttackRange = attack;
+    mDecayRange = decay;
+    mReleaseRange = release;
+}
+
+//==============================================================================
+void SamplerSynthesiser::pushBack (ListId id, int voice)
+{
+    auto& list = getList (id);
+    auto& links = mLinks[static_cast<size_t> (voice)];
+
+    links.list = id;
+    links.prev = list.tail;
+    links.next = -1;
+
+    if (list.tail >= 0) {
+        mLinks[static_cast<size_t> (list.tail)].next = voice;
+    } else {
+        list.head = voice;
+    }
+
+    list.tail = voice;
+}
+
+void SamplerSynthesiser::release (int voice)
+{
+    // A voice already released keeps its place, so stealing still takes the
+    // one released longest ago, however often its note is hit or let go of
+    if (mLinks[static_cast<size_t> (voice)].list != ListId::held) {
+        return;
+    }
+
+    unlink (voice);
+    pushBack (ListId::released, voice);
+}
+
+void SamplerSynthesiser::unlink (int voice)
+{
+    auto& links = mLinks[static_cast<size_t> (voice)];
+
+    if (links.list == ListId::none) {
+        return;
+    }
+
+    auto& list = getList (links.list);
+
+    if (links.prev >= 0) {
+        mLinks[static_cast<size_t> (links.prev)].next = links.next;
+    } else {
+        list.head = links.next;
+    }
+
+    if (links.next >= 0) {
+        mLinks[static_cast<size_t> (links.next)].prev = links.prev;
+    } else {
+        list.tail = links.prev;
+    }
+
+    links.list = ListId::none;
+    links.prev = links.next = -1;
+}
+
+void SamplerSynthesiser::linkToNote (int voice, int note)
+{
+    auto& links = mLinks[static_cast<size_t> (voice)];
+    auto& head = mNoteHeads[static_cast<size_t> (note)];
+
+    links.note = note;
+    links.prevInNote = -1;
+    links.nextInNote = head;
+
+    if (head >= 0) {
+        mLinks[static_cast<size_t> (head)].prevInNote = voice;
+    }
+
+    head = voice;
+}
+
+void SamplerSynthesiser::unlinkFromNote (int voice)
+{
+    auto& links = mLinks[static_cast<size_t> (voice)];
+
+    if (links.note < 0) {
+        return;
+    }
+
+    if (links.prevInNote >= 0) {
+        mLinks[static_cast<size_t> (links.prevInNote)].nextInNote = links.nextInNote;
+    } else {
+        mNoteHeads[static_cast<size_t> (links.note)] = links.nextInNote;
+    }
+
+    if (links.nextInNote >= 0) {
+        mLinks[static_cast<size_t> (links.nextInNote)].prevInNote = links.prevInNote;
+    }
+
+    links.note = -1;
+    links.prevInNote = links.nextInNote = -1;
+}
+
+int SamplerSynthesiser::allocateVoice()
+{
+    if (mNumFree > 0) {
+        ++mNumActive;
+        return mFreeVoices[static_cast<size_t> (--mNumFree)];
+    }
+
+    if (!isNoteStealingEnabled()) {
+        return -1;
+    }
+
+    // Furthest into its release is the quietest bet, otherwise the oldest held note
+    auto victim = mReleased.head >= 0 ? mReleased.head : mHeld.head;
+
+    if (victim >= 0) {
+        unlink (victim);
+        unlinkFromNote (victim);
+    }
+
+    return victim;
+}
+
+void SamplerSynthesiser::reclaimFinishedVoices()
+{
+    for (auto id : { ListId::held, ListId::released }) {
+        for (auto voice = getList (id).head; voice >= 0;) {
+            auto next = mLinks[static_cast<size_t> (voice)].next;
+
+            if (!mPool[static_cast<size_t> (voice)]->isRendering()) {
+                unlink (voice);
+                unlinkFromNote (voice);
+                mFreeVoices[static_cast<size_t> (mNumFree++)] = voice;
+                --mNumActive;
+            }
+
+            voice = next;
+        }
+    }
+}
+
+void SamplerSynthesiser::startZones (int midiChannel, int midiNoteNumber, float velocity, int fadeInSamples)
+{
+    // Every layer of the note's (key, velocity) cell that's due in the round robin
+    auto midiVelocity = juce::jlimit (1, 127, juce::roundToInt (velocity * 127.0f));
+
+    mZoneMap->forEachZone (midiNoteNumber, midiVelocity, [&] (const ZoneMap::Zone& zone) {
+        auto voice = allocateVoice();
+
+        if (voice < 0) {
+            return;
+        }
+
+        auto* v = mPool[static_cast<size_t> (voice)];
+        startVoice (v, zone.sound, midiChannel, midiNoteNumber, velocity);
+
+        if (fadeInSamples > 0) {
+            v->startCrossfade (fadeInSamples, true);
+        }
+
+        pushBack (ListId::held, voice);
+        linkToNote (voice, midiNoteNumber);
+    });
+}
+
+//==============================================================================
+void SamplerSynthesiser::noteOn (int midiChannel, int midiNoteNumber, float velocity)
+{
+    const juce::ScopedLock sl (lock);
+
+    if (!juce::isPositiveAndBelow (midiNoteNumber, 128)) {
+        return;
+    }
+
+    if (juce::isPositiveAndNotGreaterThan (midiChannel, 16) && midiChannel > 0) {
+        auto& key = mKeyVelocities[static_cast<size_t> (midiChannel - 1)][static_cast<size_t> (midiNoteNumber)];
+
+        if (key == 0) {
+            mNumKeysDown.fetch_add (1, std::memory_order_relaxed);
+        }
+
+        key = static_cast<juce::uint8> (juce::jlimit (1, 127, juce::roundToInt (velocity * 127.0f)));
+    }
+
+    if (mZoneMap == nullptr) {
+        return;
+    }
+
+    // If hitting a note that's still ringing, stop it first (it could be
+    // still playing because of the sustain or sostenuto pedal).
+    for (auto voice = mNoteHeads[static_cast<size_t> (midiNoteNumber)]; voice >= 0;) {
+        auto next = mLinks[static_cast<size_t> (voice)].nextInNote;
+        auto* v = mPool[static_cast<size_t> (voice)];
+
+        if (v->getCurrentlyPlayingNote() == midiNoteNumber && v->isPlayingChannel (midiChannel)) {
+            stopVoice (v, 1.0f, true);
+            release (voice);
+        }
+
+        voice = next;
+    }
+
+    startZones (midiChannel, midiNoteNumber, velocity, 0);
+}
+
+void SamplerSynthesiser::noteOff (int midiChannel, int midiNoteNumber, float velocity, bool allowTailOff)
+{
+    const juce::ScopedLock sl (lock);
+
+    if (!juce::isPositiveAndBelow (midiNoteNumber, 128)) {
+        return;
+    }
+
+    if (juce::isPositiveAndNotGreaterThan (midiChannel, 16) && midiChannel > 0) {
+        auto& key = mKeyVelocities[static_cast<size_t> (midiChannel - 1)][static_cast<size_t> (midiNoteNumber)];
+
+        if (key != 0) {
+            mNumKeysDown.fetch_sub (1, std::memory_order_relaxed);
+            key = 0;
+        }
+    }
+
+    for (auto voice = mNoteHeads[static_cast<size_t> (midiNoteNumber)]; voice >= 0;) {
+        auto next = mLinks[static_cast<size_t> (voice)].nextInNote;
+        auto* v = mPool[static_cast<size_t> (voice)];
+
+        if (v->getCurrentlyPlayingNote() == midiNoteNumber && v->isPlayingChannel (midiChannel)) {
+            if (auto sound = v->getCurrentlyPlayingSound()) {
+                if (sound->appliesToNote (midiNoteNumber) && sound->appliesToChannel (midiChannel)) {
+                    v->setKeyDown (false);
+
+                    if (!(v->isSustainPedalDown() || v->isSostenutoPedalDown())) {
+                        stopVoice (v, velocity, allowTailOff);
+                        release (voice);
+                    }
+                }
+            }
+        }
+
+        voice = next;
+    }
+}
+
+void SamplerSynthesiser::allNotesOff (int midiChannel, bool allowTailOff)
+{
+    const juce::ScopedLock sl (lock);
+
+    for (int ch = 1; ch <= 16; ++ch) {
+        if (midiChannel > 0 && midiChannel != ch) {
+            continue;
+        }
+
+        for (auto& key : mKeyVelocities[static_cast<size_t> (ch - 1)]) {
+            if (key != 0) {
+                mNumKeysDown.fetch_sub (1, std::memory_order_relaxed);
+                key = 0;
+            }
+        }
+    }
+
+    // The voices stopped here go back on the free stack once they fall silent
+    juce::Synthesiser::allNotesOff (midiChannel, allowTailOff);
+
+    for (auto voice = mHeld.head; voice >= 0;) {
+        auto next = mLinks[static_cast<size_t> (voice)].next;
+        release (voice);
+        voice = next;
+    }
+}
+
+void SamplerSynthesiser::handleController (int midiChannel, int controllerNumber, int controllerValue)
+{
+    juce::Synthesiser::handleController (midiChannel, controllerNumber, controllerValue);
+
+    // Sound controllers only change the envelope of notes started from here on,
+    // which the per-event block splitting makes sample-accurate
+    auto* range = controllerNumber == 73 ? &mAttackRange
+                : controllerNumber == 75 ? &mDecayRange
+                : controllerNumber == 72 ? &mReleaseRange
+                : nullptr;
+
+    if (range == nullptr || range->getRange().isEmpty()) {
+        return;
+    }
+
+    auto value = range->convertFrom0to1 (static_cast<float> (controllerValue) / 127.0f);
+
+    if (mZoneMap == nullptr) {
+        return;
+    }
+
+    for (auto* sound : mZoneMap->getSounds()) {
+        auto params = sound->getEnvelopeParameters();
+
+        if (controllerNumber == 73) {
+            params.attack = value;
+        } else if (controllerNumber == 75) {
+            params.decay = value;
+        } else {
+            params.release = value;
+        }
+
+        sound->setEnvelopeParameters (params);
+    }
+}
+
+void SamplerSynthesiser::handleSustainPedal (int midiChannel, bool isDown)
+{
+    const juce::ScopedLock sl (lock);
+    juce::Synthesiser::handleSustainPedal (midiChannel, isDown);
+
+    if (!isDown) {
+        releaseUnheldVoices();
+    }
+}
+
+void SamplerSynthesiser::handleSostenutoPedal (int midiChannel, bool isDown)
+{
+    const juce::ScopedLock sl (lock);
+    juce::Synthesiser::handleSostenutoPedal (midiChannel, isDown);
+
+    if (!isDown) {
+        releaseUnheldVoices();
+    }
+}
+
+void SamplerSynthesiser::releaseUnheldVoices()
+{
+    // The base class has just stopped whichever voices only the pedal was
+    // holding, they go to the released list like any other note-off
+    for (auto voice = mHeld.head; voice >= 0;) {
+        auto next = mLinks[static_cast<size_t> (voice)].next;
+        auto* v = mPool[static_cast<size_t> (voice)];
+
+        if (!(v->isKeyDown() || v->isSustainPedalDown() || v->isSostenutoPedalDown())) {
+            release (voice);
+        }
+
+        voice = next;
+    }
+}
+
+void SamplerSynthesiser::renderVoices (juce::AudioBuffer<float>& outputAudio, int startSample, int numSamples)
+{
+    // Free voices have nothing to render, so only gather the sounding ones
+    int numSounding = 0;
+
+    for (auto id : { ListId::held, ListId::released }) {
+        for (auto voice = getList (id).head; voice >= 0; voice = mLinks[static_cast<size_t> (voice)].next) {
+            mSounding[static_cast<size_t> (numSounding++)] = mPool[static_cast<size_t> (voice)];
+        }
+    }
+
+    mRenderPool.render (mSounding.data(), numSounding, outputAudio, startSample, numSamples);
+
+    reclaimFinishedVoices();
+}
+
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class SamplerSynthesiserTests  : public juce::UnitTest
+{
+public:
+    SamplerSynthesiserTests()
+        : juce::UnitTest ("SamplerSynthesiser", "BasicSampler")
+    {
+    }
+
+    void runTest() override
+    {
+        juce::TemporaryFile temp (".wav");
+        expect (writeTone (temp.getFile()));
+
+        juce::AudioFormatManager formatManager;
+        formatManager.registerBasicFormats();
+
+        juce::SharedResourcePointer<SampleCache> cache;
+        auto sample = cache->getSample (temp.getFile(), 4096, CompactSampleBuffer::Format::float32, {}, formatManager);
+        expect (sample != nullptr);
+
+        if (sample == nullptr) {
+            return;
+        }
+
+        juce::BigInteger keys;
+        keys.setRange (0, 128, true);
+
+        ZoneMap::Description zone;
+        zone.file = temp.getFile();
+        std::vector<juce::ReferenceCountedObjectPtr<StreamingSamplerSound>> sounds { new StreamingSamplerSound (sample, formatManager, keys, 60, 0.0, 0.1) };
+        ZoneMap::Ptr zoneMap = new ZoneMap ({ zone }, sounds);
+
+        testSustainReleaseIsStolenFirst (*zoneMap);
+        testRetriggerKeepsReleaseOrder (*zoneMap);
+
+        cache->purgeUnused();
+    }
+
+private:
+    void testSustainReleaseIsStolenFirst (ZoneMap& zoneMap)
+    {
+        beginTest ("A note let go of by the sustain pedal is stolen before a held one");
+
+        SamplerSynthesiser synth;
+        prepareSynth (synth, 2, zoneMap);
+
+        // 60 is held by the pedal alone by the time 62 starts, and let go of
+        // when the pedal comes up, while 62 is still held by its key
+        synth.noteOn (1, 60, 1.0f);
+        synth.handleController (1, 64, 127);
+        synth.noteOff (1, 60, 0.0f, true);
+        synth.noteOn (1, 62, 1.0f);
+        synth.handleController (1, 64, 0);
+
+        expect (isPlaying (synth, 60), "the released note should still be ringing");
+        expect (isPlaying (synth, 62));
+
+        // Both voices are in use, so this has to steal one
+        synth.noteOn (1, 64, 1.0f);
+
+        expect (isPlaying (synth, 64));
+        expect (isPlaying (synth, 62), "the held note was stolen");
+        expect (!isPlaying (synth, 60), "the note released by the pedal should have been stolen");
+
+        synth.allNotesOff (0, false);
+    }
+
+    void testRetriggerKeepsReleaseOrder (ZoneMap& zoneMap)
+    {
+        beginTest ("Retriggering a released note doesn't move it down the steal order");
+
+        SamplerSynthesiser synth;
+        prepareSynth (synth, 3, zoneMap);
+
+        // Both notes are sustained, then released in turn by the pedal, 60 first
+        synth.handleController (1, 64, 127);
+        synth.noteOn (1, 60, 1.0f);
+        synth.noteOff (1, 60, 0.0f, true);
+        synth.noteOn (1, 62, 1.0f);
+        synth.noteOff (1, 62, 0.0f, true);
+        synth.handleController (1, 64, 0);
+
+        // Hitting 60 again stops its ringing voice a second time, which leaves
+        // it where it was, the oldest released
+        synth.noteOn (1, 60, 1.0f);
+
+        expect (isPlaying (synth, 62));
+
+        // Every voice is in use, so this steals the one 60 rang on before
+        synth.noteOn (1, 64, 1.0f);
+
+        expect (isPlaying (synth, 64));
+        expect (isPlaying (synth, 60), "the retriggered note was stolen");
+        expect (isPlaying (synth, 62), "the note released after the retriggered one was stolen first");
+
+        synth.allNotesOff (0, false);
+    }
+
+    static void prepareSynth (SamplerSynthesiser& synth, int polyphony, ZoneMap& zoneMap)
+    {
+        synth.setCurrentPlaybackSampleRate (44100.0);
+        synth.setPolyphony (polyphony, [] { return new StreamingSamplerVoice(); });
+        synth.prepare (1, 2, 512, false);
+        synth.setZoneMap (&zoneMap);
+    }
+
+    static bool isPlaying (const SamplerSynthesiser& synth, int midiNoteNumber)
+    {
+        for (int i = 0; i < synth.getNumVoices(); ++i) {
+            auto* voice = synth.getVoice (i);
+
+            if (voice->isVoiceActive() && voice->getCurrentlyPlayingNote() == midiNoteNumber) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    static bool writeTone (const juce::File& file)
+    {
+        constexpr int numFrames { 44100 };
+        juce::AudioBuffer<float> tone (2, numFrames);
+
+        for (int i = 0; i < numFrames; ++i) {
+            auto value = 0.5f * std::sin (juce::MathConstants<float>::twoPi * 440.0f * static_cast<float> (i) / 44100.0f);
+            tone.setSample (0, i, value);
+            tone.setSample (1, i, value);
+        }
+
+        juce::WavAudioFormat wav;
+        std::unique_ptr<juce::AudioFormatWriter> writer { wav.createWriterFor (new juce::FileOutputStream (file), 44100.0, 2, 16, {}, 0) };
+        return writer != nullptr && writer->writeFromAudioSampleBuffer (tone, 0, numFrames);
+    }
+};
+
+static SamplerSynthesiserTests samplerSynthesiserTests;
+
+#endif
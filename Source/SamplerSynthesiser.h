@@ -0,0 +1,164 @@
+/*
+  ==============================================================================
+
+    SamplerSynthesiser.h
+    Created: 17 Oct 2026 11:05:52am
+    Author:  Adam Chung
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "StreamingSamplerVoice.h"
+#include "VoiceRenderPool.h"
+#include "ZoneMap.h"
+
+//==============================================================================
+/*
+    juce::Synthesiser with the bits the sampler needs on the audio thread.
+
+    Note-ons are looked up in a ZoneMap rather than the base class's sound
+    list, so an instrument can have any number of zones.
+
+    Voices come from a pool with a free list, so finding a voice for a note-on
+    never scans the whole pool. Voices that are sounding are kept in start
+    order in two lists, held and released, and stealing takes the oldest
+    released voice, or the oldest held one if nothing is releasing. A voice
+    moves to the released list however it's let go of: by its key, or by the
+    sustain or sostenuto pedal coming up. Each note
+    also keeps a list of the voices playing it for note-offs and retriggers.
+
+    The sounding voices are handed to a VoiceRenderPool, which may spread them
+    over several threads.
+
+    Blocks are split at every MIDI event, however close together, so notes and
+    controller changes land on their exact sample. Which keys are down is kept
+    in a fixed table per channel, so overlapping notes are tracked properly.
+*/
+class SamplerSynthesiser  : public juce::Synthesiser
+{
+public:
+    SamplerSynthesiser();
+    ~SamplerSynthesiser() override;
+
+    // Audio thread only. Replaces the instrument without allocating, and
+    // without ever dropping the last reference to the old one - whoever
+    // published the map is expected to keep it alive until it's released.
+    // Notes already ringing finish on the old instrument. With crossfadeSamples
+    // above 0 the keys still held down are also started on the new one, and
+    // their old voices fade out as the new ones fade in, at equal power.
+    void setZoneMap (ZoneMap* newZoneMap, int crossfadeSamples = 0);
+
+    // Not for the audio thread. Grows the pool with createVoice as needed, voices
+    // past the new polyphony stay allocated but are never handed out.
+    void setPolyphony (int numVoices, const std::function<StreamingSamplerVoice*()>& createVoice);
+    int getPolyphony() const { return mPolyphony; }
+
+    int getNumActiveVoices() const { return mNumActive; }
+
+    // Not for the audio thread, and after setPolyphony(). Lays the working
+    // buffers of every voice in the pool and of the render pool out in one
+    // arena, and starts the render workers: 1 renders every voice on the audio
+    // thread. From here until the next call the audio path allocates nothing.
+    // Offline the voices get bigger buffers to work through in fewer chunks.
+    void prepare (int numRenderThreads, int numChannels, int maxBlockSize, bool offline);
+
+    // Audio thread. Offline, voices wait for the disk rather than drop out and
+    // any two sounding voices are worth spreading over the render threads.
+    void setOffline (bool offline);
+
+    // Not for the audio thread. Stops the render workers, the voices keep their buffers.
+    void releaseRenderThreads() { mRenderPool.release(); }
+
+    VoiceRenderPool& getRenderPool() { return mRenderPool; }
+    const RealtimeArena& getArena() const { return mArena; }
+
+    // Audio thread. Applies to every zone, for the notes started from here on:
+    // each voice keeps the envelope its note started with.
+    void setEnvelopeParameters (const juce::ADSR::Parameters& parameters);
+
+    // Audio thread. Sets every voice's filter, and takes the filters out of the
+    // render path altogether while the type is off.
+    void setFilterParameters (const VoiceFilter::Parameters& parameters);
+
+    // Any thread. Number of keys currently held down, across all channels.
+    int getNumKeysDown() const { return mNumKeysDown.load (std::memory_order_relaxed); }
+    bool isKeyDown (int midiChannel, int midiNoteNumber) const;
+
+    // Not for the audio thread. Ranges the envelope sound controllers (CC 73
+    // attack, 75 decay, 72 release) are mapped onto.
+    void setEnvelopeControllerRanges (juce::NormalisableRange<float> attack,
+                                      juce::NormalisableRange<float> decay,
+                                      juce::NormalisableRange<float> release);
+
+    void noteOn (int midiChannel, int midiNoteNumber, float velocity) override;
+    void noteOff (int midiChannel, int midiNoteNumber, float velocity, bool allowTailOff) override;
+    void allNotesOff (int midiChannel, bool allowTailOff) override;
+    void handleController (int midiChannel, int controllerNumber, int controllerValue) override;
+    void handleSustainPedal (int midiChannel, bool isDown) override;
+    void handleSostenutoPedal (int midiChannel, bool isDown) override;
+
+protected:
+    void renderVoices (juce::AudioBuffer<float>& outputAudio, int startSample, int numSamples) override;
+    using juce::Synthesiser::renderVoices;
+
+private:
+    enum class ListId { none, held, released };
+
+    struct List
+    {
+        int head { -1 };
+        int tail { -1 };
+    };
+
+    struct VoiceLinks
+    {
+        ListId list { ListId::none };
+        int prev { -1 };
+        int next { -1 };
+
+        int note { -1 };
+        int prevInNote { -1 };
+        int nextInNote { -1 };
+    };
+
+    int allocateVoice();
+    void startZones (int midiChannel, int midiNoteNumber, float velocity, int fadeInSamples);
+    void reclaimFinishedVoices();
+    void releaseUnheldVoices();
+
+    List& getList (ListId id) { return id == ListId::held ? mHeld : mReleased; }
+    void pushBack (ListId id, int voice);
+    void release (int voice);   // held to the back of released, anything else stays put
+    void unlink (int voice);
+    void linkToNote (int voice, int note);
+    void unlinkFromNote (int voice);
+
+    ZoneMap::Ptr mZoneMap;
+
+    std::vector<StreamingSamplerVoice*> mPool;
+    std::vector<StreamingSamplerVoice*> mSounding;
+    std::vector<VoiceLinks> mLinks;
+    std::vector<int> mFreeVoices;
+    int mNumFree { 0 };
+    int mNumActive { 0 };
+    int mPolyphony { 0 };
+
+    List mHeld, mReleased;
+    std::array<int, 128> mNoteHeads;
+
+    // Velocity of every key that's down, 0 if it's up, indexed by channel - 1
+    std::array<std::array<juce::uint8, 128>, 16> mKeyVelocities {};
+    std::atomic<int> mNumKeysDown { 0 };
+
+    juce::NormalisableRange<float> mAttackRange, mDecayRange, mReleaseRange;
+
+    RealtimeArena mArena;
+
+    // Declared last so the workers are stopped before anything they render from goes
+    VoiceRenderPool mRenderPool;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SamplerSynthesiser)
+};
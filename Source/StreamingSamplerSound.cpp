@@ -0,0 +1,106 @@
+/*
+  ==============================================================================
+
+    StreamingSamplerSound.cpp
+    Created: 17 Oct 2026 9:12:40am
+    Author:  Adam Chung
+
+  ==============================================================================
+*/
+
+#include "StreamingSamplerSound.h"
+
+//==============================================================================
+StreamingSamplerSound::StreamingSamplerSound (SampleCache::Sample::Ptr sample,
+                                              juce::AudioFormatManager& formatManager,
+                                              const juce::BigInteger& midiNotes,
+                                              int midiNoteForNormalPitch,
+                                              double attackTimeSecs,
+                                              double releaseTimeSecs)
+    : mName (sample->getFile().getFileNameWithoutExtension()),
+      mSample (std::move (sample)),
+      mFormatManager (formatManager),
+      mMidiNotes (midiNotes),
+      mMidiRootNote (midiNoteForNormalPitch)
+{
+    mADSRParams.attack = static_cast<float> (attackTimeSecs);
+    mADSRParams.release = static_cast<float> (releaseTimeSecs);
+}
+
+StreamingSamplerSound::~StreamingSamplerSound()
+{
+}
+
+bool StreamingSamplerSound::appliesToNote (int midiNoteNumber)
+{
+    return mMidiNotes[midiNoteNumber];
+}
+
+bool StreamingSamplerSound::appliesToChannel (int /*midiChannel*/)
+{
+    return true;
+}
+
+int StreamingSamplerSound::getPreloadLength() const
+{
+    auto length = mSample->getPreloadLength();
+    return isLooping() ? static_cast<int> (juce::jmin<juce::int64> (length, mSample->getLoopEnd())) : length;
+}
+
+juce::int64 StreamingSamplerSound::toSampleFrame (juce::int64 frame) const
+{
+    if (!isLooping() || frame < mSample->getLoopEnd()) {
+        return frame;
+    }
+
+    auto loopStart = mSample->getLoopStart();
+    return loopStart + (frame - loopStart) % (mSample->getLoopEnd() - loopStart);
+}
+
+double StreamingSamplerSound::getFilePosition (double position) const
+{
+    auto frame = static_cast<juce::int64> (position);
+    return static_cast<double> (mSample->getStartFrame() + toSampleFrame (frame)) + (position - static_cast<double> (frame));
+}
+
+void StreamingSamplerSound::readMapped (juce::AudioBuffer<float>& dest, int destStartFrame, int numFrames, juce::int64 startFrame) const
+{
+    forEachRun (startFrame, numFrames, [&] (juce::int64 sampleFrame, juce::int64 numInRun, juce::int64 offset) {
+        mSample->readMapped (dest, destStartFrame + static_cast<int> (offset), static_cast<int> (numInRun), sampleFrame);
+    });
+}
+
+void StreamingSamplerSound::touchMapped (juce::int64 startFrame, juce::int64 numFrames) const
+{
+    // Once the playhead is in the loop there's only ever the loop to touch
+    if (isLooping()) {
+        numFrames = juce::jmin (numFrames, mSample->getLoopEnd());
+    }
+
+    forEachRun (startFrame, numFrames, [&] (juce::int64 sampleFrame, juce::int64 numInRun, juce::int64) {
+        mSample->touchMapped (sampleFrame, numInRun);
+    });
+}
+
+void StreamingSamplerSound::readFrames (juce::AudioBuffer<float>& dest, int destStartFrame, int numFrames, juce::int64 sourceStartFrame)
+{
+    if (numFrames <= 0) {
+        return;
+    }
+
+    if (mReader == nullptr && !mReaderFailed) {
+        mReader.reset (mFormatManager.createReaderFor (mSample->getFile()));
+        mReaderFailed = mReader == nullptr;
+    }
+
+    if (mReader == nullptr) {
+        dest.clear (destStartFrame, numFrames);
+        return;
+    }
+
+    // The reader sees the whole file, trimmed start included
+    forEachRun (sourceStartFrame, numFrames, [&] (juce::int64 sampleFrame, juce::int64 numInRun, juce::int64 offset) {
+        mReader->read (&dest, destStartFrame + static_cast<int> (offset), static_cast<int> (numInRun),
+                       mSample->getStartFrame() + sampleFrame, true, true);
+    });
+}
@@ -0,0 +1,116 @@
+/*
+  ==============================================================================
+
+    StreamingSamplerSound.h
+    Created: 17 Oct 2026 9:12:40am
+    Author:  Adam Chung
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "SampleCache.h"
+
+//==============================================================================
+/*
+    A sampler sound that only keeps a short preload head of the file in memory.
+    Everything past the head is pulled from disk by the SampleStreamer into the
+    ring buffer of whichever voice is playing it.
+
+    The head lives in the process-wide SampleCache, so sounds of the same file
+    share it across instances. Each sound opens its own reader, on the streamer
+    thread, the first time it has to stream.
+
+    Voices count frames from the start of the sample as preprocessing trimmed
+    it. A sample with a loop plays on endlessly: frames past the loop end wrap
+    back to the loop start, which the sound resolves on every read, so voices
+    and the streamer can treat the sound as one long run of frames.
+*/
+class StreamingSamplerSound  : public juce::SynthesiserSound
+{
+public:
+    StreamingSamplerSound (SampleCache::Sample::Ptr sample,
+                           juce::AudioFormatManager& formatManager,
+                           const juce::BigInteger& midiNotes,
+                           int midiNoteForNormalPitch,
+                           double attackTimeSecs,
+                           double releaseTimeSecs);
+    ~StreamingSamplerSound() override;
+
+    bool appliesToNote (int midiNoteNumber) override;
+    bool appliesToChannel (int midiChannel) override;
+
+    const juce::String& getName() const { return mName; }
+
+    const CompactSampleBuffer& getPreloadBuffer() const { return mSample->getPreloadBuffer(); }
+    double getSourceSampleRate() const { return mSample->getSampleRate(); }
+    float getGain() const { return mSample->getGain(); }
+
+    // Frames played straight out of the preload head. A loop ending inside the
+    // head has its repeats streamed like everything else past it.
+    int getPreloadLength() const;
+
+    // Frames the sound plays for, endless if it loops
+    juce::int64 getLength() const { return isLooping() ? endlessLength : mSample->getLength(); }
+    bool isLooping() const { return mSample->hasLoop(); }
+
+    // Where a playback position is in the file itself, for display
+    double getFilePosition (double position) const;
+
+    // Mapped sounds are read straight from the file mapping by the voices, see
+    // SampleCache::Sample. Any thread.
+    bool isMapped() const { return mSample->isMapped(); }
+    void readMapped (juce::AudioBuffer<float>& dest, int destStartFrame, int numFrames, juce::int64 startFrame) const;
+    void touchMapped (juce::int64 startFrame, juce::int64 numFrames) const;
+    int getMidiRootNote() const { return mMidiRootNote; }
+
+    void setEnvelopeParameters (juce::ADSR::Parameters parametersToUse) { mADSRParams = parametersToUse; }
+    const juce::ADSR::Parameters& getEnvelopeParameters() const { return mADSRParams; }
+
+    // Only ever called from the streamer thread
+    void readFrames (juce::AudioBuffer<float>& dest, int destStartFrame, int numFrames, juce::int64 sourceStartFrame);
+
+    // Frames of each file that stay resident in RAM, unless the loader asks
+    // for less to fit a large instrument in memory
+    static constexpr int preloadFrames { 32768 };
+
+    static constexpr juce::int64 endlessLength { std::numeric_limits<juce::int64>::max() / 4 };
+
+private:
+    juce::int64 toSampleFrame (juce::int64 frame) const;
+
+    // Splits a run of playback frames into runs of sample frames, wherever the loop
+    // wraps, and calls back with (sampleFrame, numFrames, offset into the run)
+    template <typename Callback>
+    void forEachRun (juce::int64 startFrame, juce::int64 numFrames, Callback&& callback) const
+    {
+        for (juce::int64 done = 0; done < numFrames;) {
+            auto sampleFrame = toSampleFrame (startFrame + done);
+            auto numInRun = numFrames - done;
+
+            if (isLooping()) {
+                numInRun = juce::jmin (numInRun, mSample->getLoopEnd() - sampleFrame);
+            }
+
+            callback (sampleFrame, numInRun, done);
+            done += numInRun;
+        }
+    }
+
+    juce::String mName;
+    SampleCache::Sample::Ptr mSample;
+
+    // Streamer thread only
+    juce::AudioFormatManager& mFormatManager;
+    std::unique_ptr<juce::AudioFormatReader> mReader;
+    bool mReaderFailed { false };
+
+    juce::BigInteger mMidiNotes;
+    int mMidiRootNote { 60 };
+
+    juce::ADSR::Parameters mADSRParams;
+
+    JUCE_LEAK_DETECTOR (StreamingSamplerSound)
+};
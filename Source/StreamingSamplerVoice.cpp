@@ -0,0 +1,548 @@
+/*
+  ==============================================================================
+
+    StreamingSamplerVoice.cpp
+    Created: 17 Oct 2026 9:20:03am
+    Author:  Adam Chung
+
+  ==============================================================================
+*/
+
+#include "StreamingSamplerVoice.h"
+#include "RealtimeChecker.h"
+
+//==============================================================================
+StreamingSamplerVoice::StreamingSamplerVoice()
+{
+    mRing.setSize (2, ringFrames);
+    mRing.clear();
+}
+
+StreamingSamplerVoice::~StreamingSamplerVoice()
+{
+}
+
+void StreamingSamplerVoice::prepare (RealtimeArena& arena, int numScratchFrames)
+{
+    mScratchFrames = numScratchFrames;
+    arena.allocateBuffer (mScratch, 2, numScratchFrames);
+    mGains = arena.allocate<float> (static_cast<size_t> (numScratchFrames));
+    arena.allocateBuffer (mTail, 2, fadeOutSamples);
+    mStretcher.prepare (arena);
+
+    mTailPosition = 0;
+    mTailLength = 0;
+}
+
+size_t StreamingSamplerVoice::getArenaSize (int numScratchFrames)
+{
+    return RealtimeArena::getBufferSizeFor (2, numScratchFrames)
+         + RealtimeArena::getSizeFor<float> (static_cast<size_t> (numScratchFrames))
+         + RealtimeArena::getBufferSizeFor (2, fadeOutSamples)
+         + TimeStretcher::getArenaSize();
+}
+
+bool StreamingSamplerVoice::canPlaySound (juce::SynthesiserSound* sound)
+{
+    return dynamic_cast<const StreamingSamplerSound*> (sound) != nullptr;
+}
+
+void StreamingSamplerVoice::startNote (int midiNoteNumber, float velocity, juce::SynthesiserSound* s, int /*currentPitchWheelPosition*/)
+{
+    if (auto* sound = dynamic_cast<StreamingSamplerSound*> (s)) {
+        mSound = sound;
+        mPitchRatio = std::pow (2.0, (midiNoteNumber - sound->getMidiRootNote()) / 12.0)
+                        * sound->getSourceSampleRate() / getSampleRate();
+        mSourcePosition = 0.0;
+        mGain = velocity * sound->getGain();
+        mCrossfadeLength = 0;
+
+        mRenderKernel = VoiceRenderKernels::get (mInterpolation, mPitchRatio);
+
+        // Each note keeps the playback mode it started with
+        mIsStretching = mStretchSettings.enabled;
+
+        if (mIsStretching) {
+            auto speedRatio = mStretchSettings.speed * sound->getSourceSampleRate() / getSampleRate();
+            mStretcher.start (mPitchRatio, speedRatio, mStretchSettings.numGrains);
+        }
+
+        mEnvelope.setSampleRate (getSampleRate());
+        mEnvelope.noteOn (sound->getEnvelopeParameters());
+
+        // The filter carries on from a stolen note still fading out, rather than
+        // cutting its tail short
+        mFilter.setSampleRate (getSampleRate());
+
+        if (mTailPosition >= mTailLength) {
+            mFilter.reset();
+        }
+
+        mFilter.noteOn();
+
+        startStreaming (sound);
+    } else {
+        jassertfalse; // this voice only plays StreamingSamplerSounds
+    }
+}
+
+void StreamingSamplerVoice::stopNote (float /*velocity*/, bool allowTailOff)
+{
+    if (allowTailOff) {
+        mEnvelope.noteOff();
+        mFilter.noteOff();
+    } else {
+        // Hard stops, voice stealing included, get a short ramp instead of a click
+        captureFadeOut();
+        endNote();
+    }
+}
+
+void StreamingSamplerVoice::captureFadeOut()
+{
+    if (mSound == nullptr) {
+        return;
+    }
+
+    // Keep whatever is left of an earlier fade-out and render this one on top
+    auto remaining = mTailLength - mTailPosition;
+
+    for (int ch = 0; ch < mTail.getNumChannels(); ++ch) {
+        auto* data = mTail.getWritePointer (ch);
+        std::memmove (data, data + mTailPosition, sizeof (float) * static_cast<size_t> (remaining));
+    }
+
+    mTail.clear (remaining, fadeOutSamples - remaining);
+
+    mIsFadingOut = true;
+    renderNote (mTail, 0, fadeOutSamples);
+    mIsFadingOut = false;
+
+    mTailPosition = 0;
+    mTailLength = fadeOutSamples;
+}
+
+void StreamingSamplerVoice::mixFadeOut (juce::AudioBuffer<float>& outputBuffer, int startSample, int numSamples)
+{
+    auto numToMix = juce::jmin (numSamples, mTailLength - mTailPosition);
+
+    if (numToMix <= 0) {
+        return;
+    }
+
+    if (outputBuffer.getNumChannels() > 1) {
+        outputBuffer.addFrom (0, startSample, mTail, 0, mTailPosition, numToMix);
+        outputBuffer.addFrom (1, startSample, mTail, 1, mTailPosition, numToMix);
+    } else {
+        outputBuffer.addFrom (0, startSample, mTail, 0, mTailPosition, numToMix, 0.5f);
+        outputBuffer.addFrom (0, startSample, mTail, 1, mTailPosition, numToMix, 0.5f);
+    }
+
+    mTailPosition += numToMix;
+}
+
+void StreamingSamplerVoice::startCrossfade (int numSamples, bool fadeIn)
+{
+    if (!isVoiceActive()) {
+        return;
+    }
+
+    if (numSamples <= 0) {
+        if (!fadeIn) {
+            stopNote (0.0f, false);
+        }
+
+        return;
+    }
+
+    mCrossfadePosition = 0;
+    mCrossfadeLength = numSamples;
+    mCrossfadeIn = fadeIn;
+}
+
+void StreamingSamplerVoice::setInterpolation (VoiceRenderKernels::Interpolation interpolation)
+{
+    mInterpolation = interpolation;
+    mRenderKernel = VoiceRenderKernels::get (mInterpolation, mPitchRatio);
+}
+
+void StreamingSamplerVoice::pitchWheelMoved (int /*newValue*/)
+{
+}
+
+void StreamingSamplerVoice::controllerMoved (int /*controllerNumber*/, int /*newValue*/)
+{
+}
+
+void StreamingSamplerVoice::endNote()
+{
+    clearCurrentNote();
+    mEnvelope.reset();
+    stopStreaming();
+    mSound = nullptr;
+
+    if (mPlayheads != nullptr) {
+        mPlayheads->clear (mPlayheadSlot);
+    }
+}
+
+//==============================================================================
+void StreamingSamplerVoice::startStreaming (StreamingSamplerSound* sound)
+{
+    // The ring is only ever read again once the streamer has acknowledged this
+    // generation, so it is free to reset the fifo behind our back.
+    mRingBaseFrame = sound->getPreloadLength();
+    mPlayheadFrame.store (0, std::memory_order_relaxed);
+    mRequestedSound.store (sound, std::memory_order_relaxed);
+    mRequestedGeneration.fetch_add (1, std::memory_order_release);
+}
+
+void StreamingSamplerVoice::stopStreaming()
+{
+    mRequestedSound.store (nullptr, std::memory_order_relaxed);
+    mRequestedGeneration.fetch_add (1, std::memory_order_release);
+}
+
+bool StreamingSamplerVoice::fillStream (const juce::SortedSet<StreamingSamplerSound*>& registeredSounds)
+{
+    auto requested = mRequestedGeneration.load (std::memory_order_acquire);
+
+    if (requested != mServicedGeneration) {
+        auto* sound = mRequestedSound.load (std::memory_order_relaxed);
+
+        mServicedGeneration = requested;
+        mStreamSound = registeredSounds.contains (sound) ? sound : nullptr;
+        mStreamPosition = mStreamSound != nullptr ? mStreamSound->getPreloadLength() : 0;
+        mFifo.reset();
+
+        mReadyGeneration.store (requested, std::memory_order_release);
+    }
+
+    // The sound may have been retired since the last slice
+    if (mStreamSound != nullptr && !registeredSounds.contains (mStreamSound)) {
+        mStreamSound = nullptr;
+    }
+
+    if (mStreamSound == nullptr) {
+        return false;
+    }
+
+    if (mStreamSound->isMapped()) {
+        return touchAhead();
+    }
+
+    // Offline the voice may well be waiting on this, so the reads are as big as
+    // the ring allows, but no smaller than a chunk unless the sound's ending
+    auto isOfflineRead = isOffline();
+    auto remaining = mStreamSound->getLength() - mStreamPosition;
+    auto maxToRead = isOfflineRead ? ringFrames : streamChunkFrames;
+    auto numToRead = static_cast<int> (juce::jmin<juce::int64> (remaining, juce::jmin (mFifo.getFreeSpace(), maxToRead)));
+
+    if (numToRead <= 0 || (isOfflineRead && numToRead < streamChunkFrames && numToRead < remaining)) {
+        return false;
+    }
+
+    int start1, size1, start2, size2;
+    mFifo.prepareToWrite (numToRead, start1, size1, start2, size2);
+
+    mStreamSound->readFrames (mRing, start1, size1, mStreamPosition);
+    mStreamSound->readFrames (mRing, start2, size2, mStreamPosition + size1);
+
+    mFifo.finishedWrite (size1 + size2);
+    mStreamPosition += size1 + size2;
+
+    return true;
+}
+
+bool StreamingSamplerVoice::touchAhead()
+{
+    // Voices read mapped sounds themselves, all the streamer does is fault in
+    // the pages the playhead is about to reach
+    auto playhead = juce::jmax (mStreamPosition, mPlayheadFrame.load (std::memory_order_relaxed));
+    auto target = juce::jmin (mStreamSound->getLength(), playhead + ringFrames);
+
+    if (target - mStreamPosition < streamChunkFrames && target < mStreamSound->getLength()) {
+        return false;
+    }
+
+    if (target <= mStreamPosition) {
+        return false;
+    }
+
+    mStreamSound->touchMapped (mStreamPosition, target - mStreamPosition);
+    mStreamPosition = target;
+    return true;
+}
+
+int StreamingSamplerVoice::getNumSamplesBeforeEnd() const
+{
+    // Samples until the playhead passes the last frame, same cut-off as juce::SamplerVoice
+    auto framesLeft = static_cast<double> (mSound->getLength()) - mSourcePosition;
+    return framesLeft < 0.0 ? 0 : static_cast<int> (juce::jmin (framesLeft / mPitchRatio + 1.0, 1.0e9));
+}
+
+//==============================================================================
+int StreamingSamplerVoice::readFromRing (juce::int64 firstFrame, int numFrames, int destStartFrame)
+{
+    if (mReadyGeneration.load (std::memory_order_acquire) != mRequestedGeneration.load (std::memory_order_relaxed)) {
+        return 0;
+    }
+
+    // Drop whatever the playhead has already moved past
+    if (auto behind = firstFrame - mRingBaseFrame; behind > 0) {
+        auto numToDrop = static_cast<int> (juce::jmin<juce::int64> (behind, mFifo.getNumReady()));
+        mFifo.finishedRead (numToDrop);
+        mRingBaseFrame += numToDrop;
+    }
+
+    if (firstFrame != mRingBaseFrame) {
+        return 0;
+    }
+
+    // Frames are left in the ring until the next fetch, as interpolation needs
+    // to look at the last frame of this block again.
+    int start1, size1, start2, size2;
+    mFifo.prepareToRead (numFrames, start1, size1, start2, size2);
+
+    for (int ch = 0; ch < mScratch.getNumChannels(); ++ch) {
+        if (size1 > 0) {
+            mScratch.copyFrom (ch, destStartFrame, mRing, ch, start1, size1);
+        }
+        if (size2 > 0) {
+            mScratch.copyFrom (ch, destStartFrame + size1, mRing, ch, start2, size2);
+        }
+    }
+
+    return size1 + size2;
+}
+
+int StreamingSamplerVoice::waitForRing (juce::int64 firstFrame, int numFrames, int destStartFrame)
+{
+    // Offline, nobody's listening in real time
+    const RealtimeChecker::ScopedAllowance allowance;
+
+    auto deadline = juce::Time::getMillisecondCounter() + static_cast<juce::uint32> (offlineStreamTimeoutMs);
+    int numRead = 0;
+
+    // The streamer only gets room for the rest once the frames read so far are
+    // dropped, which reading from where they end does
+    while (numRead < numFrames) {
+        numRead += readFromRing (firstFrame + numRead, numFrames - numRead, destStartFrame + numRead);
+
+        if (numRead < numFrames) {
+            if (juce::Time::getMillisecondCounter() > deadline) {
+                break;
+            }
+
+            std::this_thread::yield();
+        }
+    }
+
+    return numRead;
+}
+
+void StreamingSamplerVoice::fetchFrames (juce::int64 firstFrame, int numFrames)
+{
+    auto preloadLength = mSound->getPreloadLength();
+    auto length = mSound->getLength();
+    int numFetched = 0;
+
+    // Interpolation padding can reach back before the start of the file
+    if (firstFrame < 0) {
+        numFetched = static_cast<int> (juce::jmin<juce::int64> (numFrames, -firstFrame));
+        mScratch.clear (0, numFetched);
+    }
+
+    if (auto frame = firstFrame + numFetched; numFetched < numFrames && frame < preloadLength) {
+        auto numFromPreload = static_cast<int> (juce::jmin<juce::int64> (numFrames - numFetched, preloadLength - frame));
+
+        mPreloadCursor.read (mSound->getPreloadBuffer(), mScratch, numFetched, numFromPreload, static_cast<int> (frame));
+
+        numFetched += numFromPreload;
+    }
+
+    if (auto frame = firstFrame + numFetched; numFetched < numFrames && frame < length && mSound->isMapped()) {
+        // Converted straight from the mapping, no preload or ring in between
+        auto numInFile = static_cast<int> (juce::jmin<juce::int64> (numFrames - numFetched, length - frame));
+        mSound->readMapped (mScratch, numFetched, numInFile, frame);
+        mPlayheadFrame.store (frame, std::memory_order_relaxed);
+        numFetched += numInFile;
+    }
+
+    if (auto frame = firstFrame + numFetched; numFetched < numFrames && frame < length) {
+        auto numInFile = static_cast<int> (juce::jmin<juce::int64> (numFrames - numFetched, length - frame));
+        auto numFromRing = isOffline() ? waitForRing (frame, numInFile, numFetched)
+                                       : readFromRing (frame, numInFile, numFetched);
+
+        if (numFromRing < numInFile && mUnderrunCounter != nullptr) {
+            mUnderrunCounter->fetch_add (1, std::memory_order_relaxed);
+        }
+
+        numFetched += numFromRing;
+    }
+
+    if (numFetched < numFrames) {
+        mScratch.clear (numFetched, numFrames - numFetched);
+    }
+}
+
+void StreamingSamplerVoice::renderNextBlock (juce::AudioBuffer<float>& outputBuffer, int startSample, int numSamples)
+{
+    mixFadeOut (outputBuffer, startSample, numSamples);
+    renderNote (outputBuffer, startSample, numSamples);
+}
+
+int StreamingSamplerVoice::computeGains (int numToRender, int done, bool& noteEnds)
+{
+    // mGains only has room for a chunk of scratch
+    jassert (numToRender <= mScratchFrames);
+
+    if (auto numActive = mEnvelope.render (mGains, numToRender, mGain); numActive < numToRender) {
+        numToRender = numActive;
+        noteEnds = true;
+    }
+
+    if (numToRender <= 0) {
+        return 0;
+    }
+
+    if (mCrossfadeLength > 0) {
+        // sin and cos of the same angle sum to constant power across the swap
+        auto numFading = juce::jmin (numToRender, mCrossfadeLength - mCrossfadePosition);
+
+        for (int i = 0; i < numFading; ++i) {
+            auto angle = juce::MathConstants<float>::halfPi * static_cast<float> (mCrossfadePosition + i) / static_cast<float> (mCrossfadeLength);
+            mGains[i] *= mCrossfadeIn ? std::sin (angle) : std::cos (angle);
+        }
+
+        mCrossfadePosition += numFading;
+
+        if (mCrossfadePosition >= mCrossfadeLength) {
+            mCrossfadeLength = 0;
+
+            // Faded all the way out, nothing left to play
+            if (!mCrossfadeIn) {
+                numToRender = numFading;
+                noteEnds = true;
+            }
+        }
+    }
+
+    if (mIsFadingOut) {
+        for (int i = 0; i < numToRender; ++i) {
+            mGains[i] *= 1.0f - static_cast<float> (done + i) / fadeOutSamples;
+        }
+    }
+
+    mLastEnvelope = mGain > 0.0f ? mGains[numToRender - 1] / mGain : 0.0f;
+    return numToRender;
+}
+
+void StreamingSamplerVoice::renderNote (juce::AudioBuffer<float>& outputBuffer, int startSample, int numSamples)
+{
+    if (mSound == nullptr) {
+        return;
+    }
+
+    if (mIsStretching) {
+        renderStretched (outputBuffer, startSample, numSamples);
+        return;
+    }
+
+    auto* outL = outputBuffer.getWritePointer (0, startSample);
+    auto* outR = outputBuffer.getNumChannels() > 1 ? outputBuffer.getWritePointer (1, startSample) : nullptr;
+
+    // Render in chunks small enough that the source frames they touch, interpolation
+    // padding included, fit in the scratch buffer, and so do their gains. Pitched
+    // down, a chunk reads fewer frames than it renders.
+    constexpr auto padding = VoiceRenderKernels::paddingFrames;
+    auto maxChunk = juce::jlimit (1, mScratchFrames, static_cast<int> ((mScratchFrames - 2 * padding - 3) / mPitchRatio));
+    int done = 0;
+
+    while (done < numSamples) {
+        auto numThisChunk = juce::jmin (numSamples - done, maxChunk);
+        auto firstFrame = static_cast<juce::int64> (mSourcePosition);
+        auto localPosition = mSourcePosition - static_cast<double> (firstFrame);
+        auto numFrames = juce::jmin (mScratchFrames, static_cast<int> (localPosition + (numThisChunk - 1) * mPitchRatio) + 2 + 2 * padding);
+
+        fetchFrames (firstFrame - padding, numFrames);
+
+        // The envelope and the end of the sample are resolved up front, a block at a
+        // time, so the kernel itself never has to branch per sample
+        auto numToRender = juce::jmin (numThisChunk, getNumSamplesBeforeEnd());
+        auto noteEnds = numToRender < numThisChunk;
+
+        numToRender = computeGains (numToRender, done, noteEnds);
+
+        if (numToRender <= 0) {
+            endNote();
+            return;
+        }
+
+        VoiceRenderKernels::Block block;
+        block.sourceL = mScratch.getReadPointer (0, padding);
+        block.sourceR = mScratch.getReadPointer (1, padding);
+        block.position = localPosition;
+        block.increment = mPitchRatio;
+        block.gains = mGains;
+        block.outL = outL + done;
+        block.outR = outR != nullptr ? outR + done : nullptr;
+        block.numSamples = numToRender;
+
+        localPosition = mRenderKernel (block);
+
+        if (noteEnds) {
+            endNote();
+            return;
+        }
+
+        mSourcePosition = static_cast<double> (firstFrame) + localPosition;
+        done += numThisChunk;
+    }
+
+    if (mPlayheads != nullptr) {
+        mPlayheads->publish (mPlayheadSlot, mSound->getFilePosition (mSourcePosition), mPitchRatio, mLastEnvelope);
+    }
+}
+
+void StreamingSamplerVoice::renderStretched (juce::AudioBuffer<float>& outputBuffer, int startSample, int numSamples)
+{
+    auto* outL = outputBuffer.getWritePointer (0, startSample);
+    auto* outR = outputBuffer.getNumChannels() > 1 ? outputBuffer.getWritePointer (1, startSample) : nullptr;
+    auto length = mSound->getLength();
+    int done = 0;
+
+    // Grains only ever start at the front of a chunk
+    while (done < numSamples) {
+        auto numThisChunk = juce::jmin (numSamples - done, mStretcher.getMaxChunk());
+
+        // The history is filled front to back, just as a repitched note reads the sample
+        for (auto needed = mStretcher.getFramesNeeded (numThisChunk, length); mStretcher.getHistoryEnd() < needed;) {
+            auto numFrames = static_cast<int> (juce::jmin<juce::int64> (mScratchFrames, needed - mStretcher.getHistoryEnd()));
+            fetchFrames (mStretcher.getHistoryEnd(), numFrames);
+            mStretcher.write (mScratch, numFrames);
+        }
+
+        // The stretcher says when the sample's run out, once its last grain is over
+        auto noteEnds = false;
+        auto numToRender = computeGains (numThisChunk, done, noteEnds);
+
+        if (numToRender <= 0) {
+            endNote();
+            return;
+        }
+
+        mStretcher.render (mRenderKernel, mGains, outL + done, outR != nullptr ? outR + done : nullptr, numToRender, length);
+
+        if (noteEnds || mStretcher.isFinished()) {
+            endNote();
+            return;
+        }
+
+        done += numThisChunk;
+    }
+
+    if (mPlayheads != nullptr) {
+        mPlayheads->publish (mPlayheadSlot, mSound->getFilePosition (mStretcher.getPosition()), mPitchRatio, mLastEnvelope);
+    }
+}
@@ -0,0 +1,187 @@
+/*
+  ==============================================================================
+
+    StreamingSamplerVoice.h
+    Created: 17 Oct 2026 9:20:03am
+    Author:  Adam Chung
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "StreamingSamplerSound.h"
+#include "VoicePlayheads.h"
+#include "VoiceRenderKernels.h"
+#include "BlockEnvelope.h"
+#include "RealtimeArena.h"
+#include "TimeStretcher.h"
+#include "VoiceFilter.h"
+
+//==============================================================================
+/*
+    Plays a StreamingSamplerSound. The first StreamingSamplerSound::preloadFrames
+    come straight from the sound's preload head, the rest from a per-voice ring
+    buffer that the SampleStreamer keeps topped up ahead of the playhead.
+    Memory-mapped sounds skip both and are read from the mapping, with the
+    streamer faulting pages in ahead of the playhead instead.
+
+    The audio thread never touches the file: if the ring runs dry the missing
+    frames are rendered as silence and counted as an underrun. Offline, where
+    nothing has to happen in real time, the voice waits for the streamer
+    instead, and the streamer reads as far ahead as the ring allows.
+
+    Notes can also be played time-stretched, at a speed independent of their
+    pitch: the same source frames then feed a TimeStretcher's grains instead of
+    going straight through the render kernel.
+
+    Each voice also has a VoiceFilter, following its notes. The voice doesn't
+    run it itself: the VoiceRenderPool filters the voices' output a few at a
+    time, whenever the filter is switched on.
+*/
+class StreamingSamplerVoice  : public juce::SynthesiserVoice
+{
+public:
+    StreamingSamplerVoice();
+    ~StreamingSamplerVoice() override;
+
+    bool canPlaySound (juce::SynthesiserSound* sound) override;
+
+    void startNote (int midiNoteNumber, float velocity, juce::SynthesiserSound* sound, int currentPitchWheelPosition) override;
+    void stopNote (float velocity, bool allowTailOff) override;
+
+    void pitchWheelMoved (int newValue) override;
+    void controllerMoved (int controllerNumber, int newValue) override;
+
+    void renderNextBlock (juce::AudioBuffer<float>& outputBuffer, int startSample, int numSamples) override;
+    using juce::SynthesiserVoice::renderNextBlock;
+
+    // True while a note or the fade-out of a cut-off note still has to be rendered
+    bool isRendering() const { return isVoiceActive() || mTailPosition < mTailLength; }
+
+    // Not for the audio thread. Takes the voice's working buffers from arena,
+    // which must have getArenaSize() bytes left for the same numScratchFrames.
+    // Drops any fade-out in progress.
+    void prepare (RealtimeArena& arena, int numScratchFrames);
+    static size_t getArenaSize (int numScratchFrames);
+
+    //==============================================================================
+    // Streamer thread side. Returns true if any frames were read from disk.
+    bool fillStream (const juce::SortedSet<StreamingSamplerSound*>& registeredSounds);
+
+    // Not for the audio thread. Where the voice counts its underruns, shared
+    // with the other voices so the total can be read without taking a lock.
+    void setUnderrunCounter (std::atomic<int>* counter) { mUnderrunCounter = counter; }
+
+    // Audio thread. Takes effect straight away, ringing notes included.
+    void setInterpolation (VoiceRenderKernels::Interpolation interpolation);
+
+    // Audio thread. Fades the note in or out over numSamples with an equal-power
+    // curve, for swapping instruments under held keys. A note that has faded
+    // out ends there and then.
+    void startCrossfade (int numSamples, bool fadeIn);
+
+    // Audio thread. Applies to the notes started from here on.
+    void setStretchSettings (const TimeStretcher::Settings& settings) { mStretchSettings = settings; }
+
+    // Audio thread. Offline a dry ring is waited for rather than rendered as silence.
+    void setOffline (bool shouldBeOffline) { mOffline.store (shouldBeOffline, std::memory_order_relaxed); }
+    bool isOffline() const { return mOffline.load (std::memory_order_relaxed); }
+
+    // The voice's filter, which follows its notes. Its parameters are set on
+    // the audio thread, see VoiceFilter::setParameters().
+    VoiceFilter& getFilter() { return mFilter; }
+
+    // Where this voice reports its position at the end of every block
+    void setPlayheadSlot (VoicePlayheads* playheads, int slot) { mPlayheads = playheads; mPlayheadSlot = slot; }
+
+    // Frames of look-ahead each voice keeps buffered past the preload head
+    static constexpr int ringFrames { 32768 };
+    static constexpr int streamChunkFrames { 8192 };
+
+    // Source frames a voice works on at a time: offline in fewer, bigger chunks
+    static constexpr int scratchFrames { 4096 };
+    static constexpr int offlineScratchFrames { 16384 };
+
+    // Length of the ramp a note gets when it's cut off, e.g. by voice stealing
+    static constexpr int fadeOutSamples { 128 };
+
+    // How long an offline voice waits on the streamer before giving up on a read
+    static constexpr int offlineStreamTimeoutMs { 2000 };
+
+private:
+    void startStreaming (StreamingSamplerSound* sound);
+    void stopStreaming();
+    void endNote();
+    void captureFadeOut();
+
+    void renderNote (juce::AudioBuffer<float>& outputBuffer, int startSample, int numSamples);
+    void renderStretched (juce::AudioBuffer<float>& outputBuffer, int startSample, int numSamples);
+    int computeGains (int numToRender, int done, bool& noteEnds);
+    void mixFadeOut (juce::AudioBuffer<float>& outputBuffer, int startSample, int numSamples);
+
+    void fetchFrames (juce::int64 firstFrame, int numFrames);
+    int readFromRing (juce::int64 firstFrame, int numFrames, int destStartFrame);
+    int waitForRing (juce::int64 firstFrame, int numFrames, int destStartFrame);
+    bool touchAhead();
+    int getNumSamplesBeforeEnd() const;
+
+    StreamingSamplerSound* mSound { nullptr };
+    double mPitchRatio { 0.0 };
+    double mSourcePosition { 0.0 };
+    float mGain { 0.0f };
+    float mLastEnvelope { 0.0f };
+
+    VoicePlayheads* mPlayheads { nullptr };
+    int mPlayheadSlot { -1 };
+
+    BlockEnvelope mEnvelope;   // with its own copy of the sound's parameters from when the note started
+
+    VoiceFilter mFilter;
+
+    TimeStretcher mStretcher;
+    TimeStretcher::Settings mStretchSettings;
+    bool mIsStretching { false };   // whether the current note was started stretched
+
+    // In the arena, see prepare()
+    juce::AudioBuffer<float> mScratch;
+    int mScratchFrames { 0 };
+    CompactSampleBuffer::Cursor mPreloadCursor;   // decodes compact preload heads ahead into mScratch
+    float* mGains { nullptr };
+
+    // The faded out end of a cut-off note, mixed in over the following blocks
+    juce::AudioBuffer<float> mTail;
+    int mTailPosition { 0 };
+    int mTailLength { 0 };
+    bool mIsFadingOut { false };
+
+    // Instrument swap crossfade, see startCrossfade()
+    int mCrossfadePosition { 0 };
+    int mCrossfadeLength { 0 };
+    bool mCrossfadeIn { false };
+
+    VoiceRenderKernels::Interpolation mInterpolation { VoiceRenderKernels::Interpolation::linear };
+    VoiceRenderKernels::Function mRenderKernel { VoiceRenderKernels::getBest() };
+
+    // Ring shared with the streamer thread. The audio thread is the only consumer,
+    // the streamer the only producer. The voice's own, as the streamer keeps
+    // filling it while the arena is laid out again.
+    juce::AudioBuffer<float> mRing;
+    juce::AbstractFifo mFifo { ringFrames };
+    juce::int64 mRingBaseFrame { 0 };
+
+    std::atomic<StreamingSamplerSound*> mRequestedSound { nullptr };
+    std::atomic<int> mRequestedGeneration { 0 };
+    std::atomic<int> mReadyGeneration { 0 };
+    std::atomic<int>* mUnderrunCounter { nullptr };
+    std::atomic<juce::int64> mPlayheadFrame { 0 };   // how far a mapped sound has been read
+    std::atomic<bool> mOffline { false };
+
+    // Owned by the streamer thread
+    StreamingSamplerSound* mStreamSound { nullptr };
+    juce::int64 mStreamPosition { 0 };
+    int mServicedGeneration { 0 };
+
+    JUCE_LEAK_DETECTOR (StreamingSamplerVoice)
+};
@@ -0,0 +1,340 @@
+/*
+  ==============================================================================
+
+    TimeStretcher.cpp
+    Created: 18 Oct 2026 3:41:08am
+    Author:  Adam Chung
+
+  ==============================================================================
+*/
+
+#include "TimeStretcher.h"
+
+#if JUCE_INTEL
+ #include <immintrin.h>
+#endif
+
+#if JUCE_ARM && defined (__ARM_NEON)
+ #include <arm_neon.h>
+ #define BASICSAMPLER_HAS_NEON 1
+#else
+ #define BASICSAMPLER_HAS_NEON 0
+#endif
+
+namespace
+{
+    constexpr int historyMask { TimeStretcher::historyFrames - 1 };
+    constexpr int maxChunk { TimeStretcher::grainSamples / TimeStretcher::minGrains };
+
+    // Steps the coarse alignment search takes, before looking at every frame around the best
+    constexpr int coarseStep { 8 };
+
+    struct WindowTables
+    {
+        WindowTables()
+        {
+            constexpr auto n = TimeStretcher::grainSamples;
+
+            // Periodic, so that overlapping by grainSamples / k sums to exactly k / 2
+            for (int i = 0; i < n; ++i) {
+                hann[static_cast<size_t> (i)] = 0.5f - 0.5f * std::cos (juce::MathConstants<float>::twoPi * static_cast<float> (i) / n);
+            }
+
+            // Whatever the grains after the first leave short of the full level
+            for (int k = TimeStretcher::minGrains; k <= TimeStretcher::maxGrains; ++k) {
+                auto hop = n / k;
+                auto& table = first[static_cast<size_t> (k)];
+
+                for (int i = 0; i < n; ++i) {
+                    auto level = 0.5f * static_cast<float> (k);
+
+                    for (int start = hop; start <= i; start += hop) {
+                        level -= hann[static_cast<size_t> (i - start)];
+                    }
+
+                    table[static_cast<size_t> (i)] = level;
+                }
+            }
+        }
+
+        std::array<float, TimeStretcher::grainSamples> hann;
+        std::array<std::array<float, TimeStretcher::grainSamples>, TimeStretcher::maxGrains + 1> first;
+    };
+
+    const WindowTables& getWindowTables()
+    {
+        static const WindowTables tables;
+        return tables;
+    }
+
+    float dotProduct (const float* a, const float* b, int numSamples)
+    {
+        int i = 0;
+        float sum = 0.0f;
+
+       #if JUCE_INTEL
+        auto vSum = _mm_setzero_ps();
+
+        for (; i + 4 <= numSamples; i += 4) {
+            vSum = _mm_add_ps (vSum, _mm_mul_ps (_mm_loadu_ps (a + i), _mm_loadu_ps (b + i)));
+        }
+
+        alignas (16) float lanes[4];
+        _mm_store_ps (lanes, vSum);
+        sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+       #elif BASICSAMPLER_HAS_NEON
+        auto vSum = vdupq_n_f32 (0.0f);
+
+        for (; i + 4 <= numSamples; i += 4) {
+            vSum = vmlaq_f32 (vSum, vld1q_f32 (a + i), vld1q_f32 (b + i));
+        }
+
+        sum = vaddvq_f32 (vSum);
+       #endif
+
+        for (; i < numSamples; ++i) {
+            sum += a[i] * b[i];
+        }
+
+        return sum;
+    }
+}
+
+//==============================================================================
+TimeStretcher::TimeStretcher()
+{
+}
+
+TimeStretcher::~TimeStretcher()
+{
+}
+
+void TimeStretcher::prepareTables()
+{
+    getWindowTables();
+}
+
+const juce::StringArray& TimeStretcher::getPlaybackNames()
+{
+    static const juce::StringArray names { "Repitch", "Time Stretch" };
+    return names;
+}
+
+void TimeStretcher::prepare (RealtimeArena& arena)
+{
+    for (auto& history : mHistory) {
+        history = arena.allocate<float> (2 * historyFrames);
+    }
+
+    mScaledGains = arena.allocate<float> (maxChunk);
+    mGrainGains = arena.allocate<float> (maxChunk);
+    mNumActive = 0;
+}
+
+size_t TimeStretcher::getArenaSize()
+{
+    return 2 * RealtimeArena::getSizeFor<float> (2 * historyFrames)
+         + 2 * RealtimeArena::getSizeFor<float> (maxChunk);
+}
+
+void TimeStretcher::start (double pitchRatio, double speedRatio, int numGrains)
+{
+    mPitchRatio = juce::jmin (pitchRatio, maxRatio);
+    mSpeedRatio = juce::jlimit (0.0, maxRatio, speedRatio);
+    mNumGrains = juce::jlimit (minGrains, maxGrains, numGrains);
+    mHop = grainSamples / mNumGrains;
+
+    mSamplesToNextGrain = 0;
+    mPosition = 0.0;
+    mHasStarted = false;
+    mNumActive = 0;
+
+    // Far enough back for the interpolation padding of a grain moved as early as it goes
+    mHistoryEnd = -(alignmentFrames + VoiceRenderKernels::paddingFrames);
+}
+
+//==============================================================================
+juce::int64 TimeStretcher::getReach (double position, int numSamples) const
+{
+    // One past the last frame a kernel reads rendering numSamples from position
+    return static_cast<juce::int64> (std::floor (position + numSamples * mPitchRatio)) + VoiceRenderKernels::paddingFrames + 2;
+}
+
+juce::int64 TimeStretcher::getFramesNeeded (int numSamples, juce::int64 sampleLength) const
+{
+    auto needed = mHistoryEnd;
+
+    for (int i = 0; i < mNumActive; ++i) {
+        needed = juce::jmax (needed, getReach (mGrains[static_cast<size_t> (i)].position, numSamples));
+    }
+
+    // A grain starting at the front of the chunk, anywhere it might be moved to,
+    // and the stretch of the grain before it that it's lined up with
+    if (mSamplesToNextGrain == 0 && mPosition < static_cast<double> (sampleLength)) {
+        auto latest = std::floor (mPosition) + alignmentFrames;
+        needed = juce::jmax (needed, getReach (latest + 1.0, numSamples), static_cast<juce::int64> (latest) + matchFrames);
+
+        if (mNumActive > 0) {
+            auto reference = std::floor (mGrains[static_cast<size_t> (mNumActive - 1)].position);
+            needed = juce::jmax (needed, static_cast<juce::int64> (reference) + matchFrames);
+        }
+    }
+
+    return needed;
+}
+
+void TimeStretcher::write (const juce::AudioBuffer<float>& source, int numFrames)
+{
+    jassert (numFrames <= historyFrames);
+
+    for (int ch = 0; ch < 2; ++ch) {
+        auto* data = source.getReadPointer (juce::jmin (ch, source.getNumChannels() - 1));
+        auto* history = mHistory[static_cast<size_t> (ch)];
+        int done = 0;
+
+        while (done < numFrames) {
+            auto index = static_cast<int> ((mHistoryEnd + done) & historyMask);
+            auto numThisRun = juce::jmin (numFrames - done, historyFrames - index);
+
+            // Every frame is kept twice, so any read can run on past the end of the first copy
+            juce::FloatVectorOperations::copy (history + index, data + done, numThisRun);
+            juce::FloatVectorOperations::copy (history + index + historyFrames, data + done, numThisRun);
+
+            done += numThisRun;
+        }
+    }
+
+    mHistoryEnd += numFrames;
+}
+
+const float* TimeStretcher::getHistory (int channel, juce::int64 frame) const
+{
+    // The grains have to stay close enough together for the history to hold all of them
+    jassert (frame - VoiceRenderKernels::paddingFrames >= mHistoryEnd - historyFrames);
+
+    auto index = static_cast<int> (frame & historyMask);
+
+    // The second copy, so there's padding before it to read
+    if (index < VoiceRenderKernels::paddingFrames) {
+        index += historyFrames;
+    }
+
+    return mHistory[static_cast<size_t> (channel)] + index;
+}
+
+//==============================================================================
+float TimeStretcher::compare (juce::int64 reference, juce::int64 candidate) const
+{
+    return dotProduct (getHistory (0, reference), getHistory (0, candidate), matchFrames)
+         + dotProduct (getHistory (1, reference), getHistory (1, candidate), matchFrames);
+}
+
+int TimeStretcher::findAlignment (juce::int64 reference, juce::int64 nominal) const
+{
+    // Ties go to the nominal position
+    int best = 0;
+    auto bestMatch = compare (reference, nominal);
+
+    for (int offset = -alignmentFrames; offset <= alignmentFrames; offset += coarseStep) {
+        if (auto match = compare (reference, nominal + offset); match > bestMatch) {
+            best = offset;
+            bestMatch = match;
+        }
+    }
+
+    auto coarseBest = best;
+
+    for (int offset = juce::jmax (-alignmentFrames, coarseBest - coarseStep + 1);
+         offset < juce::jmin (alignmentFrames + 1, coarseBest + coarseStep); ++offset) {
+        if (auto match = compare (reference, nominal + offset); match > bestMatch) {
+            best = offset;
+            bestMatch = match;
+        }
+    }
+
+    return best;
+}
+
+void TimeStretcher::startGrain (juce::int64 sampleLength)
+{
+    mSamplesToNextGrain = mHop;
+
+    // Past the end, the grains already going just fade away
+    if (mPosition >= static_cast<double> (sampleLength)) {
+        mHasStarted = true;
+        return;
+    }
+
+    Grain grain;
+
+    if (!mHasStarted || mNumActive == 0) {
+        grain.position = mPosition;
+        grain.isFirst = !mHasStarted;
+        mHasStarted = true;
+    } else {
+        // Lined up with where the latest grain has got to, keeping its fraction of a frame
+        const auto& latest = mGrains[static_cast<size_t> (mNumActive - 1)];
+        auto reference = static_cast<juce::int64> (std::floor (latest.position));
+        auto nominal = static_cast<juce::int64> (std::floor (mPosition));
+
+        grain.position = static_cast<double> (nominal + findAlignment (reference, nominal))
+                           + (latest.position - static_cast<double> (reference));
+    }
+
+    // A grain lasts numGrains hops, so there's always room
+    jassert (mNumActive < maxGrains);
+    mGrains[static_cast<size_t> (juce::jmin (mNumActive++, maxGrains - 1))] = grain;
+
+    mPosition += mHop * mSpeedRatio;
+}
+
+void TimeStretcher::render (VoiceRenderKernels::Function kernel, const float* gains,
+                            float* outL, float* outR, int numSamples, juce::int64 sampleLength)
+{
+    jassert (numSamples <= getMaxChunk());
+
+    if (mSamplesToNextGrain == 0) {
+        startGrain (sampleLength);
+    }
+
+    mSamplesToNextGrain -= numSamples;
+
+    const auto& tables = getWindowTables();
+
+    // The windows overlap to numGrains / 2
+    juce::FloatVectorOperations::copyWithMultiply (mScaledGains, gains, 2.0f / static_cast<float> (mNumGrains), numSamples);
+
+    for (int i = 0; i < mNumActive; ++i) {
+        auto& grain = mGrains[static_cast<size_t> (i)];
+        const auto& window = grain.isFirst ? tables.first[static_cast<size_t> (mNumGrains)] : tables.hann;
+
+        jassert (grain.age + numSamples <= grainSamples);
+        juce::FloatVectorOperations::multiply (mGrainGains, mScaledGains, window.data() + grain.age, numSamples);
+
+        auto base = static_cast<juce::int64> (std::floor (grain.position));
+
+        VoiceRenderKernels::Block block;
+        block.sourceL = getHistory (0, base);
+        block.sourceR = getHistory (1, base);
+        block.position = grain.position - static_cast<double> (base);
+        block.increment = mPitchRatio;
+        block.gains = mGrainGains;
+        block.outL = outL;
+        block.outR = outR;
+        block.numSamples = numSamples;
+
+        grain.position = static_cast<double> (base) + kernel (block);
+        grain.age += numSamples;
+    }
+
+    // Oldest first, so the latest grain stays at the back
+    int numKept = 0;
+
+    for (int i = 0; i < mNumActive; ++i) {
+        if (mGrains[static_cast<size_t> (i)].age < grainSamples) {
+            mGrains[static_cast<size_t> (numKept++)] = mGrains[static_cast<size_t> (i)];
+        }
+    }
+
+    mNumActive = numKept;
+}
@@ -0,0 +1,131 @@
+/*
+  ==============================================================================
+
+    TimeStretcher.h
+    Created: 18 Oct 2026 3:41:08am
+    Author:  Adam Chung
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "VoiceRenderKernels.h"
+#include "RealtimeArena.h"
+
+//==============================================================================
+/*
+    Plays a voice's sample at a pitch and a speed of its own, by overlap-adding
+    grains.
+
+    Every grain lasts grainSamples and is resampled at the note's pitch by the
+    voice's own render kernel, so it sounds with the same interpolation as a
+    repitched note. A new grain starts every grainSamples / numGrains samples,
+    nominally that much further into the sample times the speed, and is then
+    moved by up to alignmentFrames either way to where it best lines up with
+    how the previous grain carries on (WSOLA), so the overlaps don't phase.
+
+    Grains are shaped by a Hann window from a precomputed table, which
+    overlaps to a constant level at every grain count. The first grain of a
+    note has a table of its own per grain count instead, flat at first and then
+    handing over to the grains after it, so the attack isn't faded in.
+
+    The stretcher doesn't read the sample itself: the voice appends source
+    frames to its history as they're needed, through the same preload, ring and
+    mapping as a repitched note, so the sample is still read strictly front to
+    back. Reads of the history never have to wrap, every frame is kept twice.
+*/
+class TimeStretcher
+{
+public:
+    struct Settings
+    {
+        bool enabled { false };
+        float speed { 1.0f };   // 1 plays the sample in its own time, whatever the pitch
+        int numGrains { 4 };    // grains sounding at once, the cost of a voice grows with it
+    };
+
+    TimeStretcher();
+    ~TimeStretcher();
+
+    // Builds the grain windows, call once before rendering
+    static void prepareTables();
+
+    // For a playback parameter, repitching first and stretching second
+    static const juce::StringArray& getPlaybackNames();
+
+    // Not for the audio thread. The history and working buffers come out of
+    // arena, which must have getArenaSize() bytes left.
+    void prepare (RealtimeArena& arena);
+    static size_t getArenaSize();
+
+    // Starts a note at the front of the sample. Both ratios are in source frames
+    // per output sample, and are limited to maxRatio.
+    void start (double pitchRatio, double speedRatio, int numGrains);
+
+    // Once the sample has run out and the last grain has faded away
+    bool isFinished() const { return mNumActive == 0 && mHasStarted; }
+
+    // Nominal position in the sample, where the next grain will start
+    double getPosition() const { return mPosition; }
+
+    // The most that can be rendered in one go, up to the next grain
+    int getMaxChunk() const { return mSamplesToNextGrain > 0 ? mSamplesToNextGrain : mHop; }
+
+    // Everything up to this frame, exclusive, has to be in the history before
+    // the next numSamples (at most getMaxChunk()) can be rendered
+    juce::int64 getFramesNeeded (int numSamples, juce::int64 sampleLength) const;
+    juce::int64 getHistoryEnd() const { return mHistoryEnd; }
+
+    // Appends the first numFrames of source to the history
+    void write (const juce::AudioBuffer<float>& source, int numFrames);
+
+    // Adds numSamples (at most getMaxChunk()) of the grains into outL and outR,
+    // times gains. outR can be nullptr, as for the render kernels.
+    void render (VoiceRenderKernels::Function kernel, const float* gains,
+                 float* outL, float* outR, int numSamples, juce::int64 sampleLength);
+
+    static constexpr int grainSamples { 840 };   // splits evenly for every grain count
+    static constexpr int minGrains { 2 };
+    static constexpr int maxGrains { 8 };
+    static constexpr int alignmentFrames { 256 };   // how far either way a grain may move to line up
+    static constexpr int matchFrames { 256 };       // how much of two grains is compared to line them up
+    static constexpr int historyFrames { 8192 };    // a power of two
+    static constexpr double maxRatio { 4.0 };
+
+private:
+    struct Grain
+    {
+        double position { 0.0 };   // in the sample
+        int age { 0 };
+        bool isFirst { false };
+    };
+
+    void startGrain (juce::int64 sampleLength);
+    juce::int64 getReach (double position, int numSamples) const;
+    int findAlignment (juce::int64 reference, juce::int64 nominal) const;
+    float compare (juce::int64 reference, juce::int64 candidate) const;
+
+    // Where frame starts in the history, with paddingFrames readable before it
+    const float* getHistory (int channel, juce::int64 frame) const;
+
+    double mPitchRatio { 1.0 };
+    double mSpeedRatio { 1.0 };
+    int mNumGrains { 4 };
+    int mHop { grainSamples / 4 };
+    int mSamplesToNextGrain { 0 };
+    double mPosition { 0.0 };
+    bool mHasStarted { false };
+
+    std::array<Grain, maxGrains> mGrains;
+    int mNumActive { 0 };
+
+    // In the arena, see prepare()
+    std::array<float*, 2> mHistory {};
+    juce::int64 mHistoryEnd { 0 };
+    float* mScaledGains { nullptr };
+    float* mGrainGains { nullptr };
+
+    JUCE_LEAK_DETECTOR (TimeStretcher)
+};
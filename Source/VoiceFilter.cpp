@@ -0,0 +1,333 @@
+/*
+  ==============================================================================
+
+    VoiceFilter.cpp
+    Created: 18 Oct 2026 4:26:51am
+    Author:  Adam Chung
+
+  ==============================================================================
+*/
+
+#include "VoiceFilter.h"
+
+#if JUCE_INTEL
+ #include <immintrin.h>
+#endif
+
+#if JUCE_ARM && defined (__ARM_NEON)
+ #include <arm_neon.h>
+ #define BASICSAMPLER_HAS_NEON 1
+#else
+ #define BASICSAMPLER_HAS_NEON 0
+#endif
+
+namespace
+{
+    constexpr int lanes { VoiceFilter::lanes };
+
+    // One control step's coefficients, a lane per filter. Lanes without a
+    // filter are left all zero, which keeps their memory at zero and their
+    // output silent.
+    struct alignas (16) Coefficients
+    {
+        float a1[lanes], a2[lanes], a3[lanes];
+        float mix0[lanes], mix1[lanes], mix2[lanes];
+    };
+
+    // One channel of the filters' memory, a lane per filter
+    struct alignas (16) State
+    {
+        float ic1[lanes], ic2[lanes];
+    };
+
+    inline float tick (const Coefficients& c, State& s, int lane, float x)
+    {
+        auto v3 = x - s.ic2[lane];
+        auto v1 = c.a1[lane] * s.ic1[lane] + c.a2[lane] * v3;
+        auto v2 = s.ic2[lane] + c.a2[lane] * s.ic1[lane] + c.a3[lane] * v3;
+
+        s.ic1[lane] = 2.0f * v1 - s.ic1[lane];
+        s.ic2[lane] = 2.0f * v2 - s.ic2[lane];
+
+        return c.mix0[lane] * x + c.mix1[lane] * v1 + c.mix2[lane] * v2;
+    }
+
+   #if BASICSAMPLER_HAS_NEON
+    inline void transpose (float32x4_t& r0, float32x4_t& r1, float32x4_t& r2, float32x4_t& r3)
+    {
+        auto t01 = vtrnq_f32 (r0, r1);
+        auto t23 = vtrnq_f32 (r2, r3);
+
+        r0 = vcombine_f32 (vget_low_f32 (t01.val[0]), vget_low_f32 (t23.val[0]));
+        r1 = vcombine_f32 (vget_low_f32 (t01.val[1]), vget_low_f32 (t23.val[1]));
+        r2 = vcombine_f32 (vget_high_f32 (t01.val[0]), vget_high_f32 (t23.val[0]));
+        r3 = vcombine_f32 (vget_high_f32 (t01.val[1]), vget_high_f32 (t23.val[1]));
+    }
+   #endif
+
+    // Runs numSamples of each lane's input through its filter and adds the sum
+    // of the lanes, times gain, into out
+    void filterLanes (const Coefficients& c, State& s, const float* const* in, float* out, int numSamples, float gain)
+    {
+        int i = 0;
+
+        // Four samples of each lane are loaded as a row each, and transposed so
+        // every vector holds one sample of all four lanes. After filtering they
+        // go back into rows, which then simply add up to the sum of the lanes.
+       #if JUCE_INTEL
+        const auto a1 = _mm_load_ps (c.a1), a2 = _mm_load_ps (c.a2), a3 = _mm_load_ps (c.a3);
+        const auto mix0 = _mm_load_ps (c.mix0), mix1 = _mm_load_ps (c.mix1), mix2 = _mm_load_ps (c.mix2);
+        const auto two = _mm_set1_ps (2.0f);
+        const auto vGain = _mm_set1_ps (gain);
+
+        auto ic1 = _mm_load_ps (s.ic1);
+        auto ic2 = _mm_load_ps (s.ic2);
+
+        auto step = [&] (__m128 x) {
+            auto v3 = _mm_sub_ps (x, ic2);
+            auto v1 = _mm_add_ps (_mm_mul_ps (a1, ic1), _mm_mul_ps (a2, v3));
+            auto v2 = _mm_add_ps (ic2, _mm_add_ps (_mm_mul_ps (a2, ic1), _mm_mul_ps (a3, v3)));
+
+            ic1 = _mm_sub_ps (_mm_mul_ps (two, v1), ic1);
+            ic2 = _mm_sub_ps (_mm_mul_ps (two, v2), ic2);
+
+            return _mm_add_ps (_mm_mul_ps (mix0, x), _mm_add_ps (_mm_mul_ps (mix1, v1), _mm_mul_ps (mix2, v2)));
+        };
+
+        for (; i + 4 <= numSamples; i += 4) {
+            auto x0 = _mm_loadu_ps (in[0] + i);
+            auto x1 = _mm_loadu_ps (in[1] + i);
+            auto x2 = _mm_loadu_ps (in[2] + i);
+            auto x3 = _mm_loadu_ps (in[3] + i);
+
+            _MM_TRANSPOSE4_PS (x0, x1, x2, x3);
+
+            x0 = step (x0);
+            x1 = step (x1);
+            x2 = step (x2);
+            x3 = step (x3);
+
+            _MM_TRANSPOSE4_PS (x0, x1, x2, x3);
+
+            auto sum = _mm_add_ps (_mm_add_ps (x0, x1), _mm_add_ps (x2, x3));
+            _mm_storeu_ps (out + i, _mm_add_ps (_mm_loadu_ps (out + i), _mm_mul_ps (sum, vGain)));
+        }
+
+        _mm_store_ps (s.ic1, ic1);
+        _mm_store_ps (s.ic2, ic2);
+       #elif BASICSAMPLER_HAS_NEON
+        const auto a1 = vld1q_f32 (c.a1), a2 = vld1q_f32 (c.a2), a3 = vld1q_f32 (c.a3);
+        const auto mix0 = vld1q_f32 (c.mix0), mix1 = vld1q_f32 (c.mix1), mix2 = vld1q_f32 (c.mix2);
+
+        auto ic1 = vld1q_f32 (s.ic1);
+        auto ic2 = vld1q_f32 (s.ic2);
+
+        auto step = [&] (float32x4_t x) {
+            auto v3 = vsubq_f32 (x, ic2);
+            auto v1 = vmlaq_f32 (vmulq_f32 (a1, ic1), a2, v3);
+            auto v2 = vmlaq_f32 (vmlaq_f32 (ic2, a2, ic1), a3, v3);
+
+            ic1 = vsubq_f32 (vaddq_f32 (v1, v1), ic1);
+            ic2 = vsubq_f32 (vaddq_f32 (v2, v2), ic2);
+
+            return vmlaq_f32 (vmlaq_f32 (vmulq_f32 (mix0, x), mix1, v1), mix2, v2);
+        };
+
+        for (; i + 4 <= numSamples; i += 4) {
+            auto x0 = vld1q_f32 (in[0] + i);
+            auto x1 = vld1q_f32 (in[1] + i);
+            auto x2 = vld1q_f32 (in[2] + i);
+            auto x3 = vld1q_f32 (in[3] + i);
+
+            transpose (x0, x1, x2, x3);
+
+            x0 = step (x0);
+            x1 = step (x1);
+            x2 = step (x2);
+            x3 = step (x3);
+
+            transpose (x0, x1, x2, x3);
+
+            auto sum = vaddq_f32 (vaddq_f32 (x0, x1), vaddq_f32 (x2, x3));
+            vst1q_f32 (out + i, vmlaq_n_f32 (vld1q_f32 (out + i), sum, gain));
+        }
+
+        vst1q_f32 (s.ic1, ic1);
+        vst1q_f32 (s.ic2, ic2);
+       #endif
+
+        for (; i < numSamples; ++i) {
+            auto sum = 0.0f;
+
+            for (int lane = 0; lane < lanes; ++lane) {
+                sum += tick (c, s, lane, in[lane][i]);
+            }
+
+            out[i] += sum * gain;
+        }
+    }
+
+    // Memory this small has nothing audible left in it, and would soon be denormal
+    void flushDenormals (State& s)
+    {
+        for (int lane = 0; lane < lanes; ++lane) {
+            if (std::abs (s.ic1[lane]) < VoiceFilter::denormalThreshold) {
+                s.ic1[lane] = 0.0f;
+            }
+            if (std::abs (s.ic2[lane]) < VoiceFilter::denormalThreshold) {
+                s.ic2[lane] = 0.0f;
+            }
+        }
+    }
+}
+
+//==============================================================================
+VoiceFilter::VoiceFilter()
+{
+}
+
+VoiceFilter::~VoiceFilter()
+{
+}
+
+const juce::StringArray& VoiceFilter::getTypeNames()
+{
+    static const juce::StringArray names { "Off", "Low Pass", "Band Pass", "High Pass" };
+    return names;
+}
+
+void VoiceFilter::setSampleRate (double sampleRate)
+{
+    if (sampleRate == mSampleRate) {
+        return;
+    }
+
+    mSampleRate = sampleRate;
+    mEnvelope.setSampleRate (sampleRate);
+
+    // The same cutoff needs new coefficients
+    mCutoff = -1.0f;
+}
+
+void VoiceFilter::noteOn()
+{
+    mEnvelope.noteOn (mParameters.envelope);
+}
+
+void VoiceFilter::noteOff()
+{
+    mEnvelope.noteOff();
+}
+
+void VoiceFilter::reset()
+{
+    mEnvelope.reset();
+    mIc1 = {};
+    mIc2 = {};
+}
+
+void VoiceFilter::advance (int numSamples)
+{
+    jassert (numSamples <= controlInterval);
+
+    auto level = mEnvelope.getLevel();
+
+    if (mEnvelope.isActive()) {
+        float levels[controlInterval];
+        mEnvelope.render (levels, numSamples, 1.0f);
+    }
+
+    auto sampleRate = static_cast<float> (mSampleRate);
+    auto cutoff = juce::jlimit (minCutoff, maxCutoffRatio * sampleRate, mParameters.cutoff * std::exp2 (mParameters.envelopeAmount * level));
+    auto resonance = juce::jlimit (minResonance, maxResonance, mParameters.resonance);
+
+    // A held note past its decay, or no envelope at all, costs nothing from here
+    if (cutoff == mCutoff && resonance == mResonance && mParameters.type == mType) {
+        return;
+    }
+
+    mCutoff = cutoff;
+    mResonance = resonance;
+    mType = mParameters.type;
+
+    auto g = std::tan (juce::MathConstants<float>::pi * cutoff / sampleRate);
+    auto k = 1.0f / resonance;
+
+    mA1 = 1.0f / (1.0f + g * (g + k));
+    mA2 = g * mA1;
+    mA3 = g * mA2;
+
+    switch (mType) {
+        case Type::lowPass:  mMix0 = 0.0f; mMix1 = 0.0f; mMix2 = 1.0f;  break;
+        case Type::bandPass: mMix0 = 0.0f; mMix1 = k;    mMix2 = 0.0f;  break;   // unity gain at the cutoff
+        case Type::highPass: mMix0 = 1.0f; mMix1 = -k;   mMix2 = -1.0f; break;
+
+        case Type::off:
+            // Straight through
+            mA1 = mA2 = mA3 = 0.0f;
+            mMix0 = 1.0f; mMix1 = 0.0f; mMix2 = 0.0f;
+            break;
+    }
+}
+
+//==============================================================================
+void VoiceFilter::process (VoiceFilter* const* filters, const float* const* dry, int numFilters,
+                           float* outL, float* outR, int numSamples)
+{
+    jassert (numFilters > 0 && numFilters <= lanes);
+
+    Coefficients coefficients {};
+    std::array<State, 2> states {};
+    std::array<std::array<const float*, lanes>, 2> inputs;
+
+    for (int lane = 0; lane < lanes; ++lane) {
+        // Empty lanes read the first voice, their zero coefficients keep it out of the sum
+        auto voice = lane < numFilters ? lane : 0;
+
+        for (size_t ch = 0; ch < 2; ++ch) {
+            inputs[ch][static_cast<size_t> (lane)] = dry[2 * voice + static_cast<int> (ch)];
+
+            if (lane < numFilters) {
+                states[ch].ic1[lane] = filters[lane]->mIc1[ch];
+                states[ch].ic2[lane] = filters[lane]->mIc2[ch];
+            }
+        }
+    }
+
+    std::array<float*, 2> outputs { outL, outR != nullptr ? outR : outL };
+    auto gain = outR != nullptr ? 1.0f : 0.5f;
+
+    for (int start = 0; start < numSamples; start += controlInterval) {
+        auto numThisTime = juce::jmin (controlInterval, numSamples - start);
+
+        for (int lane = 0; lane < numFilters; ++lane) {
+            auto& filter = *filters[lane];
+            filter.advance (numThisTime);
+
+            coefficients.a1[lane] = filter.mA1;
+            coefficients.a2[lane] = filter.mA2;
+            coefficients.a3[lane] = filter.mA3;
+            coefficients.mix0[lane] = filter.mMix0;
+            coefficients.mix1[lane] = filter.mMix1;
+            coefficients.mix2[lane] = filter.mMix2;
+        }
+
+        for (size_t ch = 0; ch < 2; ++ch) {
+            std::array<const float*, lanes> in;
+
+            for (size_t lane = 0; lane < in.size(); ++lane) {
+                in[lane] = inputs[ch][lane] + start;
+            }
+
+            filterLanes (coefficients, states[ch], in.data(), outputs[ch] + start, numThisTime, gain);
+            flushDenormals (states[ch]);
+        }
+    }
+
+    for (int lane = 0; lane < numFilters; ++lane) {
+        for (size_t ch = 0; ch < 2; ++ch) {
+            filters[lane]->mIc1[ch] = states[ch].ic1[lane];
+            filters[lane]->mIc2[ch] = states[ch].ic2[lane];
+        }
+    }
+}
@@ -0,0 +1,112 @@
+/*
+  ==============================================================================
+
+    VoiceFilter.h
+    Created: 18 Oct 2026 4:26:51am
+    Author:  Adam Chung
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "BlockEnvelope.h"
+
+//==============================================================================
+/*
+    A voice's own resonant filter, with an envelope of its own moving the
+    cutoff.
+
+    The filter is a trapezoidal state-variable filter, low, band or high pass.
+    It stays stable and in tune right up to the top of its range, and its
+    cutoff can move from one sample to the next without blowing up, so it can
+    follow the envelope closely.
+
+    Voices aren't filtered one at a time: process() runs lanes of them side by
+    side, one voice in each lane of an SSE2 or NEON vector, transposing their
+    signals into vectors four samples at a time. The envelope and the cutoff
+    move at control rate, every controlInterval samples, and the coefficients
+    are only worked out again when the cutoff, resonance or type have actually
+    changed since the last control step.
+
+    The filter's memory is flushed to zero after every control step once it
+    falls below denormalThreshold, so a voice decaying into silence never
+    leaves it ringing on in denormals, whatever the thread's floating point
+    mode.
+*/
+class VoiceFilter
+{
+public:
+    enum class Type { off, lowPass, bandPass, highPass };
+
+    struct Parameters
+    {
+        Type type { Type::off };
+        float cutoff { 20000.0f };      // Hz
+        float resonance { 0.707f };     // Q
+        float envelopeAmount { 0.0f };  // octaves the cutoff moves by at the envelope's peak
+        juce::ADSR::Parameters envelope;
+    };
+
+    VoiceFilter();
+    ~VoiceFilter();
+
+    // For a filter type parameter, in the order of Type
+    static const juce::StringArray& getTypeNames();
+
+    void setSampleRate (double sampleRate);
+
+    // Audio thread. The envelope applies from the next note on, everything else
+    // straight away, ringing notes included.
+    void setParameters (const Parameters& parameters) { mParameters = parameters; }
+    const Parameters& getParameters() const { return mParameters; }
+
+    // Starts the envelope's attack, with a snapshot of its parameters
+    void noteOn();
+    void noteOff();
+
+    // Clears the filter's memory and stops the envelope
+    void reset();
+
+    // Filters numFilters (at most lanes) voices at once, each through its own
+    // filter, and adds the sum into outL and outR. dry has the voices' left and
+    // right channels in turn, two pointers per filter. outR can be nullptr, both
+    // channels then go into outL at half level, as for the render kernels.
+    static void process (VoiceFilter* const* filters, const float* const* dry, int numFilters,
+                         float* outL, float* outR, int numSamples);
+
+    static constexpr int lanes { 4 };
+    static constexpr int controlInterval { 32 };   // a multiple of 4
+    static constexpr float minCutoff { 20.0f };
+    static constexpr float maxCutoffRatio { 0.45f };   // of the sample rate
+    static constexpr float minResonance { 0.5f };
+    static constexpr float maxResonance { 12.0f };
+    static constexpr float denormalThreshold { 1.0e-15f };
+
+private:
+    // Moves the envelope on by numSamples, and updates the coefficients for the
+    // cutoff where it was at the start
+    void advance (int numSamples);
+
+    Parameters mParameters;
+    double mSampleRate { 44100.0 };
+
+    BlockEnvelope mEnvelope;   // with its own copy of the parameters from when the note started
+
+    // What the coefficients were last worked out for
+    Type mType { Type::off };
+    float mCutoff { -1.0f };
+    float mResonance { -1.0f };
+
+    // The filter, and how much of its input (mix0), band pass (mix1) and low
+    // pass (mix2) outputs make up the type's output
+    float mA1 { 0.0f }, mA2 { 0.0f }, mA3 { 0.0f };
+    float mMix0 { 0.0f }, mMix1 { 0.0f }, mMix2 { 0.0f };
+
+    // The filter's memory, one per channel
+    std::array<float, 2> mIc1 {};
+    std::array<float, 2> mIc2 {};
+
+    JUCE_LEAK_DETECTOR (VoiceFilter)
+};
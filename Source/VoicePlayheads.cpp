@@ -0,0 +1,82 @@
+/*
+  ==============================================================================
+
+    VoicePlayheads.cpp
+    Created: 17 Oct 2026 3:02:44pm
+    Author:  Adam Chung
+
+  ==============================================================================
+*/
+
+#include "VoicePlayheads.h"
+
+//==============================================================================
+VoicePlayheads::VoicePlayheads()
+{
+}
+
+VoicePlayheads::~VoicePlayheads()
+{
+}
+
+void VoicePlayheads::publish (int voice, double position, double rate, float level)
+{
+    write (voice, { position, rate, level, true });
+}
+
+void VoicePlayheads::clear (int voice)
+{
+    write (voice, {});
+}
+
+void VoicePlayheads::write (int voice, const State& state)
+{
+    if (!juce::isPositiveAndBelow (voice, maxVoices)) {
+        return;
+    }
+
+    auto& slot = mSlots[static_cast<size_t> (voice)];
+    auto sequence = slot.sequence.load (std::memory_order_relaxed);
+
+    // Odd while writing
+    slot.sequence.store (sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence (std::memory_order_release);
+
+    slot.position.store (state.position, std::memory_order_relaxed);
+    slot.rate.store (state.rate, std::memory_order_relaxed);
+    slot.level.store (state.level, std::memory_order_relaxed);
+    slot.active.store (state.active, std::memory_order_relaxed);
+
+    slot.sequence.store (sequence + 2, std::memory_order_release);
+}
+
+VoicePlayheads::State VoicePlayheads::read (int voice) const
+{
+    if (!juce::isPositiveAndBelow (voice, maxVoices)) {
+        return {};
+    }
+
+    const auto& slot = mSlots[static_cast<size_t> (voice)];
+
+    for (int attempt = 0; attempt < 4; ++attempt) {
+        auto before = slot.sequence.load (std::memory_order_acquire);
+
+        if ((before & 1) != 0) {
+            continue;
+        }
+
+        State state;
+        state.position = slot.position.load (std::memory_order_relaxed);
+        state.rate = slot.rate.load (std::memory_order_relaxed);
+        state.level = slot.level.load (std::memory_order_relaxed);
+        state.active = slot.active.load (std::memory_order_relaxed);
+
+        std::atomic_thread_fence (std::memory_order_acquire);
+
+        if (slot.sequence.load (std::memory_order_relaxed) == before) {
+            return state;
+        }
+    }
+
+    return {};
+}
@@ -0,0 +1,67 @@
+/*
+  ==============================================================================
+
+    VoicePlayheads.h
+    Created: 17 Oct 2026 3:02:44pm
+    Author:  Adam Chung
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/*
+    Where each voice currently is in its sample, published by the audio thread
+    for the editor to draw.
+
+    Every voice owns one slot guarded by a sequence counter (a seqlock), so
+    publishing is a handful of relaxed stores and never waits, while readers
+    simply retry if they catch a slot halfway through an update.
+*/
+class VoicePlayheads
+{
+public:
+    struct State
+    {
+        double position { 0.0 };   // in source frames
+        double rate { 0.0 };       // source frames per output sample
+        float level { 0.0f };      // current envelope gain
+        bool active { false };
+    };
+
+    VoicePlayheads();
+    ~VoicePlayheads();
+
+    // Audio thread
+    void publish (int voice, double position, double rate, float level);
+    void clear (int voice);
+
+    // Any thread. A slot that keeps changing under the reader reads as inactive.
+    State read (int voice) const;
+
+    void setNumVoices (int numVoices) { mNumVoices = juce::jlimit (0, maxVoices, numVoices); }
+    int getNumVoices() const { return mNumVoices.load(); }
+
+    static constexpr int maxVoices { 256 };
+
+private:
+    // Each slot on its own cache line so voices never contend with each other
+    struct alignas (64) Slot
+    {
+        std::atomic<juce::uint32> sequence { 0 };
+        std::atomic<double> position { 0.0 };
+        std::atomic<double> rate { 0.0 };
+        std::atomic<float> level { 0.0f };
+        std::atomic<bool> active { false };
+    };
+
+    void write (int voice, const State& state);
+
+    std::array<Slot, maxVoices> mSlots;
+    std::atomic<int> mNumVoices { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (VoicePlayheads)
+};
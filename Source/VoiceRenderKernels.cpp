@@ -0,0 +1,507 @@
+/*
+  ==============================================================================
+
+    VoiceRenderKernels.cpp
+    Created: 17 Oct 2026 4:26:51pm
+    Author:  Adam Chung
+
+  ==============================================================================
+*/
+
+#include "VoiceRenderKernels.h"
+
+#if JUCE_INTEL
+ #include <immintrin.h>
+#endif
+
+#if JUCE_ARM && defined (__ARM_NEON)
+ #include <arm_neon.h>
+ #define BASICSAMPLER_HAS_NEON 1
+#else
+ #define BASICSAMPLER_HAS_NEON 0
+#endif
+
+#if JUCE_INTEL && (defined (__GNUC__) || defined (__clang__))
+ #define BASICSAMPLER_TARGET_AVX2 __attribute__ ((target ("avx2,fma")))
+#else
+ #define BASICSAMPLER_TARGET_AVX2
+#endif
+
+namespace VoiceRenderKernels
+{
+
+//==============================================================================
+static double renderScalar (const Block& b)
+{
+    auto position = b.position;
+
+    for (int i = 0; i < b.numSamples; ++i) {
+        auto index = static_cast<int> (position);
+        auto alpha = static_cast<float> (position - index);
+
+        auto l = (b.sourceL[index] + alpha * (b.sourceL[index + 1] - b.sourceL[index])) * b.gains[i];
+        auto r = (b.sourceR[index] + alpha * (b.sourceR[index + 1] - b.sourceR[index])) * b.gains[i];
+
+        if (b.outR != nullptr) {
+            b.outL[i] += l;
+            b.outR[i] += r;
+        } else {
+            b.outL[i] += (l + r) * 0.5f;
+        }
+
+        position += b.increment;
+    }
+
+    return position;
+}
+
+// Renders whatever the vector loop left over
+static double renderTail (const Block& b, int start, double position)
+{
+    Block tail = b;
+    tail.position = position;
+    tail.gains += start;
+    tail.outL += start;
+    tail.outR = b.outR != nullptr ? b.outR + start : nullptr;
+    tail.numSamples = b.numSamples - start;
+    return renderScalar (tail);
+}
+
+//==============================================================================
+// Each group of lanes is positioned relative to the integer frame its first
+// lane falls on, so the per-lane offsets stay small enough for float maths.
+#if JUCE_INTEL
+static double renderSSE2 (const Block& b)
+{
+    const auto laneOffsets = _mm_mul_ps (_mm_set_ps (3.0f, 2.0f, 1.0f, 0.0f), _mm_set1_ps (static_cast<float> (b.increment)));
+    const auto half = _mm_set1_ps (0.5f);
+    const auto step = b.increment * 4.0;
+
+    auto position = b.position;
+    int i = 0;
+
+    for (; i + 4 <= b.numSamples; i += 4) {
+        auto base = static_cast<int> (position);
+        auto offsets = _mm_add_ps (_mm_set1_ps (static_cast<float> (position - base)), laneOffsets);
+        auto whole = _mm_cvttps_epi32 (offsets);
+        auto alpha = _mm_sub_ps (offsets, _mm_cvtepi32_ps (whole));
+
+        alignas (16) juce::int32 lanes[4];
+        _mm_store_si128 (reinterpret_cast<__m128i*> (lanes), whole);
+
+        const auto* l0 = b.sourceL + base;
+        const auto* r0 = b.sourceR + base;
+
+        auto la = _mm_set_ps (l0[lanes[3]], l0[lanes[2]], l0[lanes[1]], l0[lanes[0]]);
+        auto lb = _mm_set_ps (l0[lanes[3] + 1], l0[lanes[2] + 1], l0[lanes[1] + 1], l0[lanes[0] + 1]);
+        auto ra = _mm_set_ps (r0[lanes[3]], r0[lanes[2]], r0[lanes[1]], r0[lanes[0]]);
+        auto rb = _mm_set_ps (r0[lanes[3] + 1], r0[lanes[2] + 1], r0[lanes[1] + 1], r0[lanes[0] + 1]);
+
+        auto gain = _mm_loadu_ps (b.gains + i);
+        auto l = _mm_mul_ps (_mm_add_ps (la, _mm_mul_ps (alpha, _mm_sub_ps (lb, la))), gain);
+        auto r = _mm_mul_ps (_mm_add_ps (ra, _mm_mul_ps (alpha, _mm_sub_ps (rb, ra))), gain);
+
+        if (b.outR != nullptr) {
+            _mm_storeu_ps (b.outL + i, _mm_add_ps (_mm_loadu_ps (b.outL + i), l));
+            _mm_storeu_ps (b.outR + i, _mm_add_ps (_mm_loadu_ps (b.outR + i), r));
+        } else {
+            _mm_storeu_ps (b.outL + i, _mm_add_ps (_mm_loadu_ps (b.outL + i), _mm_mul_ps (_mm_add_ps (l, r), half)));
+        }
+
+        position += step;
+    }
+
+    return renderTail (b, i, position);
+}
+
+BASICSAMPLER_TARGET_AVX2
+static double renderAVX2 (const Block& b)
+{
+    const auto laneOffsets = _mm256_mul_ps (_mm256_set_ps (7.0f, 6.0f, 5.0f, 4.0f, 3.0f, 2.0f, 1.0f, 0.0f),
+                                            _mm256_set1_ps (static_cast<float> (b.increment)));
+    const auto half = _mm256_set1_ps (0.5f);
+    const auto step = b.increment * 8.0;
+
+    auto position = b.position;
+    int i = 0;
+
+    for (; i + 8 <= b.numSamples; i += 8) {
+        auto base = static_cast<int> (position);
+        auto offsets = _mm256_add_ps (_mm256_set1_ps (static_cast<float> (position - base)), laneOffsets);
+        auto whole = _mm256_cvttps_epi32 (offsets);
+        auto alpha = _mm256_sub_ps (offsets, _mm256_cvtepi32_ps (whole));
+
+        const auto* l0 = b.sourceL + base;
+        const auto* r0 = b.sourceR + base;
+
+        auto la = _mm256_i32gather_ps (l0, whole, 4);
+        auto lb = _mm256_i32gather_ps (l0 + 1, whole, 4);
+        auto ra = _mm256_i32gather_ps (r0, whole, 4);
+        auto rb = _mm256_i32gather_ps (r0 + 1, whole, 4);
+
+        auto gain = _mm256_loadu_ps (b.gains + i);
+        auto l = _mm256_mul_ps (_mm256_fmadd_ps (alpha, _mm256_sub_ps (lb, la), la), gain);
+        auto r = _mm256_mul_ps (_mm256_fmadd_ps (alpha, _mm256_sub_ps (rb, ra), ra), gain);
+
+        if (b.outR != nullptr) {
+            _mm256_storeu_ps (b.outL + i, _mm256_add_ps (_mm256_loadu_ps (b.outL + i), l));
+            _mm256_storeu_ps (b.outR + i, _mm256_add_ps (_mm256_loadu_ps (b.outR + i), r));
+        } else {
+            _mm256_storeu_ps (b.outL + i, _mm256_fmadd_ps (_mm256_add_ps (l, r), half, _mm256_loadu_ps (b.outL + i)));
+        }
+
+        position += step;
+    }
+
+    return renderTail (b, i, position);
+}
+#endif
+
+#if BASICSAMPLER_HAS_NEON
+static double renderNEON (const Block& b)
+{
+    const float laneIndices[4] { 0.0f, 1.0f, 2.0f, 3.0f };
+    const auto laneOffsets = vmulq_n_f32 (vld1q_f32 (laneIndices), static_cast<float> (b.increment));
+    const auto step = b.increment * 4.0;
+
+    auto position = b.position;
+    int i = 0;
+
+    for (; i + 4 <= b.numSamples; i += 4) {
+        auto base = static_cast<int> (position);
+        auto offsets = vaddq_f32 (vdupq_n_f32 (static_cast<float> (position - base)), laneOffsets);
+        auto whole = vcvtq_s32_f32 (offsets);
+        auto alpha = vsubq_f32 (offsets, vcvtq_f32_s32 (whole));
+
+        juce::int32 lanes[4];
+        vst1q_s32 (lanes, whole);
+
+        const auto* l0 = b.sourceL + base;
+        const auto* r0 = b.sourceR + base;
+
+        float la[4], lb[4], ra[4], rb[4];
+        for (int lane = 0; lane < 4; ++lane) {
+            la[lane] = l0[lanes[lane]];
+            lb[lane] = l0[lanes[lane] + 1];
+            ra[lane] = r0[lanes[lane]];
+            rb[lane] = r0[lanes[lane] + 1];
+        }
+
+        auto lA = vld1q_f32 (la);
+        auto rA = vld1q_f32 (ra);
+        auto gain = vld1q_f32 (b.gains + i);
+        auto l = vmulq_f32 (vmlaq_f32 (lA, alpha, vsubq_f32 (vld1q_f32 (lb), lA)), gain);
+        auto r = vmulq_f32 (vmlaq_f32 (rA, alpha, vsubq_f32 (vld1q_f32 (rb), rA)), gain);
+
+        if (b.outR != nullptr) {
+            vst1q_f32 (b.outL + i, vaddq_f32 (vld1q_f32 (b.outL + i), l));
+            vst1q_f32 (b.outR + i, vaddq_f32 (vld1q_f32 (b.outR + i), r));
+        } else {
+            vst1q_f32 (b.outL + i, vmlaq_n_f32 (vld1q_f32 (b.outL + i), vaddq_f32 (l, r), 0.5f));
+        }
+
+        position += step;
+    }
+
+    return renderTail (b, i, position);
+}
+#endif
+
+//==============================================================================
+// Polyphase bank of Kaiser windowed sinc filters. Row p holds the taps for a
+// fractional offset of p / numPhases, one extra row makes interpolating
+// between neighbouring phases branch free.
+struct SincTable
+{
+    static constexpr int halfTaps { 8 };
+    static constexpr int numTaps { halfTaps * 2 };
+    static constexpr int numPhases { 256 };
+    static constexpr float maxStretch { 4.0f };
+
+    SincTable()
+    {
+        constexpr double cutoff = 0.9;   // of the source Nyquist, leaves room for the transition band
+        constexpr double beta = 8.0;
+
+        auto besselI0 = [] (double x)
+        {
+            double sum = 1.0, term = 1.0;
+
+            for (int k = 1; k < 32; ++k) {
+                term *= (x * 0.5 / k) * (x * 0.5 / k);
+                sum += term;
+            }
+
+            return sum;
+        };
+
+        for (int p = 0; p <= numPhases; ++p) {
+            double total = 0.0;
+
+            for (int k = 0; k < numTaps; ++k) {
+                auto x = (k - (halfTaps - 1)) - static_cast<double> (p) / numPhases;
+                auto ratio = x / halfTaps;
+                auto window = std::abs (ratio) < 1.0 ? besselI0 (beta * std::sqrt (1.0 - ratio * ratio)) / besselI0 (beta) : 0.0;
+                auto arg = juce::MathConstants<double>::pi * cutoff * x;
+                auto sinc = std::abs (arg) < 1.0e-9 ? 1.0 : std::sin (arg) / arg;
+
+                rows[p][k] = static_cast<float> (cutoff * sinc * window);
+                total += rows[p][k];
+            }
+
+            for (int k = 0; k < numTaps; ++k) {
+                rows[p][k] = static_cast<float> (rows[p][k] / total);
+            }
+        }
+    }
+
+    // The continuous kernel, for the stretched filters used when pitching up
+    float evaluate (float x) const
+    {
+        if (x <= -halfTaps || x > halfTaps) {
+            return 0.0f;
+        }
+
+        auto whole = std::ceil (x);
+        auto phase = (whole - x) * numPhases;
+        auto p = static_cast<int> (phase);
+        auto k = static_cast<int> (whole) + halfTaps - 1;
+        auto alpha = phase - p;
+
+        return rows[p][k] + alpha * (rows[p + 1][k] - rows[p][k]);
+    }
+
+    alignas (64) float rows[numPhases + 1][numTaps];
+};
+
+static const SincTable& getSincTable()
+{
+    static const SincTable table;
+    return table;
+}
+
+void prepareTables()
+{
+    getSincTable();
+}
+
+//==============================================================================
+struct CubicHermite
+{
+    explicit CubicHermite (double) {}
+
+    float operator() (const float* s, int i, float t) const
+    {
+        auto c1 = 0.5f * (s[i + 1] - s[i - 1]);
+        auto c2 = s[i - 1] - 2.5f * s[i] + 2.0f * s[i + 1] - 0.5f * s[i + 2];
+        auto c3 = 0.5f * (s[i + 2] - s[i - 1]) + 1.5f * (s[i] - s[i + 1]);
+
+        return ((c3 * t + c2) * t + c1) * t + s[i];
+    }
+};
+
+struct WindowedSinc
+{
+    explicit WindowedSinc (double) : table (getSincTable()) {}
+
+    float operator() (const float* s, int i, float t) const
+    {
+        auto phase = t * SincTable::numPhases;
+        auto p = static_cast<int> (phase);
+        auto alpha = phase - p;
+
+        const auto* a = table.rows[p];
+        const auto* b = table.rows[p + 1];
+        const auto* x = s + i - (SincTable::halfTaps - 1);
+        auto sum = 0.0f;
+
+        for (int k = 0; k < SincTable::numTaps; ++k) {
+            sum += x[k] * (a[k] + alpha * (b[k] - a[k]));
+        }
+
+        return sum;
+    }
+
+    const SincTable& table;
+};
+
+// Pitching up: the same kernel stretched by the playback rate, which lowers the
+// cutoff below the output Nyquist at the price of proportionally more taps.
+struct StretchedSinc
+{
+    explicit StretchedSinc (double increment)
+        : table (getSincTable()),
+          scale (1.0f / juce::jlimit (1.0f, SincTable::maxStretch, static_cast<float> (increment))),
+          halfTaps (static_cast<int> (std::ceil (SincTable::halfTaps / scale)))
+    {
+    }
+
+    float operator() (const float* s, int i, float t) const
+    {
+        auto sum = 0.0f;
+        auto weights = 0.0f;
+
+        for (int k = 1 - halfTaps; k <= halfTaps; ++k) {
+            auto w = table.evaluate ((k - t) * scale);
+            sum += s[i + k] * w;
+            weights += w;
+        }
+
+        return weights > 0.0f ? sum / weights : 0.0f;
+    }
+
+    const SincTable& table;
+    float scale;
+    int halfTaps;
+};
+
+template <typename Interpolator>
+static double renderInterpolated (const Block& b)
+{
+    const Interpolator interpolate (b.increment);
+    auto position = b.position;
+
+    for (int i = 0; i < b.numSamples; ++i) {
+        auto index = static_cast<int> (position);
+        auto t = static_cast<float> (position - index);
+
+        auto l = interpolate (b.sourceL, index, t) * b.gains[i];
+        auto r = interpolate (b.sourceR, index, t) * b.gains[i];
+
+        if (b.outR != nullptr) {
+            b.outL[i] += l;
+            b.outR[i] += r;
+        } else {
+            b.outL[i] += (l + r) * 0.5f;
+        }
+
+        position += b.increment;
+    }
+
+    return position;
+}
+
+//==============================================================================
+bool isAvailable (InstructionSet instructions)
+{
+    switch (instructions) {
+        case InstructionSet::scalar: return true;
+       #if JUCE_INTEL
+        case InstructionSet::sse2:   return juce::SystemStats::hasSSE2();
+        case InstructionSet::avx2:   return juce::SystemStats::hasAVX2() && juce::SystemStats::hasFMA3();
+       #endif
+       #if BASICSAMPLER_HAS_NEON
+        case InstructionSet::neon:   return true;
+       #endif
+        default:                     return false;
+    }
+}
+
+InstructionSet getBestAvailable()
+{
+    for (auto instructions : { InstructionSet::avx2, InstructionSet::neon, InstructionSet::sse2 }) {
+        if (isAvailable (instructions)) {
+            return instructions;
+        }
+    }
+
+    return InstructionSet::scalar;
+}
+
+const char* getName (InstructionSet instructions)
+{
+    switch (instructions) {
+        case InstructionSet::sse2: return "SSE2";
+        case InstructionSet::avx2: return "AVX2";
+        case InstructionSet::neon: return "NEON";
+        case InstructionSet::scalar:
+        default:                   return "Scalar";
+    }
+}
+
+Function get (InstructionSet instructions)
+{
+    if (!isAvailable (instructions)) {
+        return renderScalar;
+    }
+
+    switch (instructions) {
+       #if JUCE_INTEL
+        case InstructionSet::sse2: return renderSSE2;
+        case InstructionSet::avx2: return renderAVX2;
+       #endif
+       #if BASICSAMPLER_HAS_NEON
+        case InstructionSet::neon: return renderNEON;
+       #endif
+        default:                   return renderScalar;
+    }
+}
+
+Function getBest()
+{
+    static const Function best = get (getBestAvailable());
+    return best;
+}
+
+Function get (Interpolation interpolation, double increment)
+{
+    switch (interpolation) {
+        case Interpolation::cubicHermite:
+            return renderInterpolated<CubicHermite>;
+        case Interpolation::windowedSinc:
+            return increment > 1.0 ? renderInterpolated<StretchedSinc> : renderInterpolated<WindowedSinc>;
+        case Interpolation::linear:
+        default:
+            return getBest();
+    }
+}
+
+const juce::StringArray& getInterpolationNames()
+{
+    static const juce::StringArray names { "Linear", "Cubic", "Sinc" };
+    return names;
+}
+
+float measureMaxErrorAgainstScalar()
+{
+    constexpr int numSamples = 509;
+    constexpr int numFrames = 4096;
+
+    juce::Random random (0x5eed);
+    std::vector<float> sourceL (numFrames), sourceR (numFrames), gains (numSamples);
+
+    for (auto& s : sourceL) { s = random.nextFloat() * 2.0f - 1.0f; }
+    for (auto& s : sourceR) { s = random.nextFloat() * 2.0f - 1.0f; }
+    for (auto& g : gains)   { g = random.nextFloat(); }
+
+    auto maxError = 0.0f;
+
+    for (auto increment : { 0.25, 0.9999, 1.0, 1.4983, 3.7 }) {
+        for (auto stereo : { true, false }) {
+            std::vector<float> expectedL (numSamples), expectedR (numSamples);
+            Block block { sourceL.data(), sourceR.data(), 0.371, increment, gains.data(),
+                          expectedL.data(), stereo ? expectedR.data() : nullptr, numSamples };
+            renderScalar (block);
+
+            for (auto instructions : { InstructionSet::sse2, InstructionSet::avx2, InstructionSet::neon }) {
+                if (!isAvailable (instructions)) {
+                    continue;
+                }
+
+                std::vector<float> actualL (numSamples), actualR (numSamples);
+                block.outL = actualL.data();
+                block.outR = stereo ? actualR.data() : nullptr;
+                get (instructions) (block);
+
+                for (int i = 0; i < numSamples; ++i) {
+                    maxError = juce::jmax (maxError, std::abs (actualL[(size_t) i] - expectedL[(size_t) i]),
+                                                     std::abs (actualR[(size_t) i] - expectedR[(size_t) i]));
+                }
+            }
+        }
+    }
+
+    return maxError;
+}
+
+} // namespace VoiceRenderKernels
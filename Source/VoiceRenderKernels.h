@@ -0,0 +1,80 @@
+/*
+  ==============================================================================
+
+    VoiceRenderKernels.h
+    Created: 17 Oct 2026 4:26:51pm
+    Author:  Adam Chung
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/*
+    Inner loops for StreamingSamplerVoice. Each kernel resamples a block of
+    stereo source frames, applies a per-sample gain and adds the result into
+    the output, all in one pass.
+
+    Linear interpolation has vectorised kernels, the widest one the CPU
+    supports is picked once at runtime and checked against the scalar one.
+    The higher quality modes each get their own instantiation of a templated
+    loop, so nothing branches on the mode per sample.
+*/
+namespace VoiceRenderKernels
+{
+    struct Block
+    {
+        // Must be readable from -paddingFrames to past the last frame + paddingFrames
+        const float* sourceL { nullptr };
+        const float* sourceR { nullptr };
+        double position { 0.0 };    // in frames, relative to sourceL/sourceR
+        double increment { 1.0 };   // source frames per output sample
+        const float* gains { nullptr };
+        float* outL { nullptr };
+        float* outR { nullptr };    // nullptr sums both channels into outL
+        int numSamples { 0 };
+    };
+
+    // Returns the position after the last rendered sample
+    using Function = double (*) (const Block&);
+
+    enum class InstructionSet
+    {
+        scalar,
+        sse2,
+        avx2,
+        neon
+    };
+
+    enum class Interpolation
+    {
+        linear,
+        cubicHermite,
+        windowedSinc
+    };
+
+    // Frames before and after the playhead that any kernel may read
+    static constexpr int paddingFrames { 40 };
+
+    // Builds the sinc filter bank, call once before rendering
+    void prepareTables();
+
+    bool isAvailable (InstructionSet instructions);
+    InstructionSet getBestAvailable();
+    const char* getName (InstructionSet instructions);
+
+    Function get (InstructionSet instructions);
+    Function getBest();
+
+    // The kernel for a mode. The sinc kernels also depend on the playback rate
+    // as pitching up needs a wider, lower cutoff filter to keep aliasing out.
+    Function get (Interpolation interpolation, double increment);
+    const juce::StringArray& getInterpolationNames();
+
+    // Renders the same random material through every available kernel and
+    // returns the largest difference from the scalar one.
+    float measureMaxErrorAgainstScalar();
+}
@@ -0,0 +1,303 @@
+/*
+  ==============================================================================
+
+    VoiceRenderPool.cpp
+    Created: 17 Oct 2026 5:48:19pm
+    Author:  Adam Chung
+
+  ==============================================================================
+*/
+
+#include "VoiceRenderPool.h"
+#include "RealtimeChecker.h"
+
+#if JUCE_INTEL
+ #include <immintrin.h>
+#endif
+
+namespace
+{
+    inline void spinPause()
+    {
+       #if JUCE_INTEL
+        _mm_pause();
+       #endif
+    }
+
+    // Roughly a couple of blocks' worth at small buffer sizes
+    constexpr int numSpinsBeforeSleeping { 20000 };
+    constexpr int sleepTimeoutMs { 100 };
+
+    // How long the audio thread waits, once it's done with its own partition,
+    // for the workers to claim theirs before rendering them itself. A worker
+    // woken from its sleep usually makes it well within this.
+    constexpr int numSpinsBeforeTakingOver { 4000 };
+}
+
+//==============================================================================
+class VoiceRenderPool::Worker  : public juce::Thread
+{
+public:
+    Worker (VoiceRenderPool& owner, int partition)
+        : juce::Thread ("Voice Renderer " + juce::String (partition)),
+          mOwner (owner),
+          mPartition (partition),
+          mSeen (owner.mGeneration.load())
+    {
+    }
+
+    ~Worker() override
+    {
+        signalThreadShouldExit();
+        notify();
+        stopThread (1000);
+    }
+
+    void wake()
+    {
+        if (mIsSleeping.load()) {
+            // The event's mutex is only held by the worker on its way to sleep,
+            // and this only happens after a quiet spell
+            const RealtimeChecker::ScopedAllowance allowance;
+            notify();
+        }
+    }
+
+    void run() override
+    {
+        // The host only turns denormals off on the audio thread, and decaying
+        // voices and filters would otherwise crawl through them here
+        const juce::ScopedNoDenormals noDenormals;
+
+        // mSeen was taken before the thread started, so a block published
+        // while it was still starting up isn't missed
+        auto seen = mSeen;
+
+        while (!threadShouldExit()) {
+            auto generation = seen;
+
+            for (int i = 0; i < numSpinsBeforeSleeping && generation == seen; ++i) {
+                spinPause();
+                generation = mOwner.mGeneration.load (std::memory_order_acquire);
+            }
+
+            if (generation == seen) {
+                // Announce the sleep before the last look, so a block published
+                // in between is either seen here or followed by a notify()
+                mIsSleeping.store (true);
+
+                if (mOwner.mGeneration.load() == seen && !threadShouldExit()) {
+                    wait (sleepTimeoutMs);
+                }
+
+                mIsSleeping.store (false);
+                continue;
+            }
+
+            seen = generation;
+
+            // The audio thread may have given up on us and rendered it already
+            if (!mOwner.claimPartition (mPartition)) {
+                continue;
+            }
+
+            {
+                const RealtimeChecker::ScopedRealtime realtime;
+                mOwner.renderPartition (mPartition);
+            }
+
+            mOwner.mNumPending.fetch_sub (1, std::memory_order_acq_rel);
+        }
+    }
+
+private:
+    VoiceRenderPool& mOwner;
+    const int mPartition;
+    const juce::uint32 mSeen;
+    std::atomic<bool> mIsSleeping { false };
+
+    JUCE_DECLARE_NON_COPYABLE (Worker)
+};
+
+//==============================================================================
+VoiceRenderPool::VoiceRenderPool()
+{
+    // Nothing to claim until the first block
+    for (auto& claimed : mClaimed) {
+        claimed.store (true);
+    }
+}
+
+VoiceRenderPool::~VoiceRenderPool()
+{
+    release();
+}
+
+void VoiceRenderPool::prepare (int numThreads, int numChannels, int maxBlockSize, RealtimeArena& arena)
+{
+    release();
+
+    numThreads = juce::jlimit (1, juce::jmin (maxThreads, juce::SystemStats::getNumCpus()), numThreads);
+    mMaxBlockSize = maxBlockSize;
+
+    for (int i = 0; i < numThreads; ++i) {
+        arena.allocateBuffer (mScratch[static_cast<size_t> (i)], numChannels, maxBlockSize);
+        arena.allocateBuffer (mDry[static_cast<size_t> (i)], 2 * VoiceFilter::lanes, maxBlockSize);
+    }
+
+    // Partition 0 belongs to the audio thread. The workers are left to the
+    // scheduler to place, it knows about the host's threads and any other
+    // instances, and go at the highest ordinary priority where realtime ones
+    // aren't allowed. Partitions have to stay contiguous, so the first worker
+    // that can't be started at all is the last one tried.
+    for (int i = 1; i < numThreads; ++i) {
+        auto worker = std::make_unique<Worker> (*this, i);
+
+        if (!worker->startRealtimeThread (juce::Thread::RealtimeOptions{}.withPriority (8))
+            && !worker->startThread (juce::Thread::Priority::highest)) {
+            break;
+        }
+
+        mWorkers.add (worker.release());
+    }
+}
+
+void VoiceRenderPool::release()
+{
+    mWorkers.clear();
+
+    for (auto& scratch : mScratch) {
+        scratch.setSize (0, 0);
+    }
+
+    for (auto& dry : mDry) {
+        dry.setSize (0, 0);
+    }
+
+    mMaxBlockSize = 0;
+}
+
+size_t VoiceRenderPool::getArenaSize (int numThreads, int numChannels, int maxBlockSize)
+{
+    return static_cast<size_t> (juce::jlimit (1, maxThreads, numThreads))
+             * (RealtimeArena::getBufferSizeFor (numChannels, maxBlockSize)
+                + RealtimeArena::getBufferSizeFor (2 * VoiceFilter::lanes, maxBlockSize));
+}
+
+//==============================================================================
+void VoiceRenderPool::render (StreamingSamplerVoice* const* voices, int numVoices,
+                              juce::AudioBuffer<float>& outputAudio, int startSample, int numSamples)
+{
+    auto numPartitions = getNumThreads();
+
+    // Hosts occasionally send more than they promised, render those blocks in place
+    if (numPartitions == 1
+        || numVoices < mParallelThreshold.load (std::memory_order_relaxed)
+        || startSample + numSamples > mMaxBlockSize
+        || outputAudio.getNumChannels() > mScratch[0].getNumChannels()) {
+        renderVoices (voices, numVoices, outputAudio, startSample, numSamples, 0);
+        return;
+    }
+
+    mVoices = voices;
+    mNumVoices = numVoices;
+    mNumChannels = outputAudio.getNumChannels();
+    mStartSample = startSample;
+    mNumSamples = numSamples;
+
+    mNumPending.store (numPartitions - 1, std::memory_order_relaxed);
+
+    // Released after everything above, so whoever claims a partition sees this block
+    for (int p = 1; p < numPartitions; ++p) {
+        mClaimed[static_cast<size_t> (p)].store (false, std::memory_order_release);
+    }
+
+    mGeneration.fetch_add (1);
+
+    for (auto* worker : mWorkers) {
+        worker->wake();
+    }
+
+    renderPartition (0);
+
+    for (int i = 0; i < numSpinsBeforeTakingOver && mNumPending.load (std::memory_order_acquire) > 0; ++i) {
+        spinPause();
+    }
+
+    // Whatever nobody has claimed by now is rendered here, rather than waited on
+    for (int p = 1; p < numPartitions; ++p) {
+        if (claimPartition (p)) {
+            renderPartition (p);
+            mNumPending.fetch_sub (1, std::memory_order_acq_rel);
+        }
+    }
+
+    // Only partitions some worker is rendering right now are left
+    while (mNumPending.load (std::memory_order_acquire) > 0) {
+        spinPause();
+    }
+
+    // Always summed in partition order so the result doesn't depend on timing
+    for (int p = 0; p < numPartitions; ++p) {
+        auto& scratch = mScratch[static_cast<size_t> (p)];
+
+        for (int ch = 0; ch < mNumChannels; ++ch) {
+            outputAudio.addFrom (ch, startSample, scratch, ch, startSample, numSamples);
+        }
+    }
+}
+
+void VoiceRenderPool::renderPartition (int partition)
+{
+    auto numPartitions = getNumThreads();
+    auto first = mNumVoices * partition / numPartitions;
+    auto last = mNumVoices * (partition + 1) / numPartitions;
+
+    auto& scratch = mScratch[static_cast<size_t> (partition)];
+
+    // Only as many channels as the output has, without reallocating anything
+    juce::AudioBuffer<float> target (scratch.getArrayOfWritePointers(), mNumChannels, mStartSample + mNumSamples);
+    target.clear (mStartSample, mNumSamples);
+
+    renderVoices (mVoices + first, last - first, target, mStartSample, mNumSamples, partition);
+}
+
+void VoiceRenderPool::renderVoices (StreamingSamplerVoice* const* voices, int numVoices, juce::AudioBuffer<float>& target,
+                                    int startSample, int numSamples, int partition)
+{
+    auto& dry = mDry[static_cast<size_t> (partition)];
+
+    if (!mFiltering || dry.getNumSamples() == 0) {
+        for (int i = 0; i < numVoices; ++i) {
+            voices[i]->renderNextBlock (target, startSample, numSamples);
+        }
+
+        return;
+    }
+
+    auto* outL = target.getWritePointer (0, startSample);
+    auto* outR = target.getNumChannels() > 1 ? target.getWritePointer (1, startSample) : nullptr;
+
+    // Oversized host blocks go through the dry buffer a buffer's worth at a time
+    for (int done = 0; done < numSamples; done += dry.getNumSamples()) {
+        auto numThisTime = juce::jmin (dry.getNumSamples(), numSamples - done);
+
+        for (int first = 0; first < numVoices; first += VoiceFilter::lanes) {
+            auto numInGroup = juce::jmin (VoiceFilter::lanes, numVoices - first);
+            std::array<VoiceFilter*, VoiceFilter::lanes> filters;
+
+            for (int lane = 0; lane < numInGroup; ++lane) {
+                // The lane's two channels, without reallocating anything
+                juce::AudioBuffer<float> laneBuffer (dry.getArrayOfWritePointers() + 2 * lane, 2, numThisTime);
+                laneBuffer.clear();
+
+                auto* voice = voices[first + lane];
+                voice->renderNextBlock (laneBuffer, 0, numThisTime);
+                filters[static_cast<size_t> (lane)] = &voice->getFilter();
+            }
+
+            VoiceFilter::process (filters.data(), dry.getArrayOfReadPointers(), numInGroup,
+                                  outL + done, outR != nullptr ? outR + done : nullptr, numThisTime);
+        }
+    }
+}
@@ -0,0 +1,104 @@
+/*
+  ==============================================================================
+
+    VoiceRenderPool.h
+    Created: 17 Oct 2026 5:48:19pm
+    Author:  Adam Chung
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "StreamingSamplerVoice.h"
+#include "RealtimeArena.h"
+
+//==============================================================================
+/*
+    Spreads the voices of a block over a few worker threads.
+
+    The sounding voices are split into one contiguous run per thread, the audio
+    thread renders the first run itself while the workers render the others
+    into their own scratch buffers, and the scratch buffers are then summed into
+    the output in thread order. For the same voices and thread count the output
+    is always the same, however the threads happen to be scheduled.
+
+    Workers spin for a while after each block before going to sleep, so in the
+    steady state a block is handed over with nothing but atomics. Below the
+    parallel threshold the voices are simply rendered on the calling thread.
+
+    Each partition is claimed by whichever thread gets to it first. The audio
+    thread only waits so long for the workers to claim theirs, and renders
+    whatever's still unclaimed itself, so a worker that never wakes up costs
+    time but can't hang the audio.
+
+    With filtering on, each thread renders its voices VoiceFilter::lanes at a
+    time into a lane each of a dry buffer of its own, and runs each group
+    through their filters together on the way into the output.
+
+    Every thread works with denormals off, as the audio thread does.
+*/
+class VoiceRenderPool
+{
+public:
+    VoiceRenderPool();
+    ~VoiceRenderPool();
+
+    // Not for the audio thread. numThreads includes the calling thread, so 1
+    // means no workers at all. Workers that can't be started are done without,
+    // see getNumThreads(). The scratch buffers come out of arena, which must
+    // have getArenaSize() bytes left for the same arguments.
+    void prepare (int numThreads, int numChannels, int maxBlockSize, RealtimeArena& arena);
+    void release();
+
+    static size_t getArenaSize (int numThreads, int numChannels, int maxBlockSize);
+
+    int getNumThreads() const { return mWorkers.size() + 1; }
+
+    // Fewest sounding voices worth waking the workers for
+    void setParallelThreshold (int numVoices) { mParallelThreshold.store (juce::jmax (1, numVoices)); }
+    int getParallelThreshold() const { return mParallelThreshold.load(); }
+
+    // Audio thread. Whether the voices go through their VoiceFilters
+    void setFiltering (bool shouldFilter) { mFiltering = shouldFilter; }
+    bool isFiltering() const { return mFiltering; }
+
+    // Audio thread. Adds every voice's output to the given range of outputAudio.
+    void render (StreamingSamplerVoice* const* voices, int numVoices,
+                 juce::AudioBuffer<float>& outputAudio, int startSample, int numSamples);
+
+    static constexpr int maxThreads { 16 };
+    static constexpr int defaultParallelThreshold { 16 };
+    static constexpr int offlineParallelThreshold { 2 };
+
+private:
+    class Worker;
+
+    bool claimPartition (int partition) { return !mClaimed[static_cast<size_t> (partition)].exchange (true, std::memory_order_acq_rel); }
+    void renderPartition (int partition);
+    void renderVoices (StreamingSamplerVoice* const* voices, int numVoices, juce::AudioBuffer<float>& target,
+                       int startSample, int numSamples, int partition);
+
+    juce::OwnedArray<Worker> mWorkers;
+    std::array<juce::AudioBuffer<float>, maxThreads> mScratch;
+    std::array<juce::AudioBuffer<float>, maxThreads> mDry;   // two channels per filter lane
+    int mMaxBlockSize { 0 };
+    bool mFiltering { false };
+    std::atomic<int> mParallelThreshold { defaultParallelThreshold };
+
+    // The current block. Written by the audio thread before mGeneration is
+    // bumped, read by the workers after they see the new generation. So is
+    // mFiltering.
+    StreamingSamplerVoice* const* mVoices { nullptr };
+    int mNumVoices { 0 };
+    int mNumChannels { 0 };
+    int mStartSample { 0 };
+    int mNumSamples { 0 };
+
+    std::atomic<juce::uint32> mGeneration { 0 };
+    std::atomic<int> mNumPending { 0 };
+    std::array<std::atomic<bool>, maxThreads> mClaimed;   // by partition, the audio thread's is never claimed
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (VoiceRenderPool)
+};
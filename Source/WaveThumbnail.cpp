@@ -1,103 +1,181 @@
-/*
-  ==============================================================================
-
-    WaveThumbnail.cpp
-    Created: 4 Feb 2024 6:14:19pm
-    Author:  Adam Chung
-
-  ==============================================================================
-*/
-
-#include <JuceHeader.h>
-#include "WaveThumbnail.h"
-
-//==============================================================================
-WaveThumbnail::WaveThumbnail(BasicSamplerAudioProcessor& p) : audioProcessor(p)
-{
-    // In your constructor, you should add any child components, and
-    // initialise any special settings that your component needs.
-
-}
-
-WaveThumbnail::~WaveThumbnail()
-{
-}
-
-void WaveThumbnail::paint (juce::Graphics& g)
-{
-    g.fillAll(juce::Colours::cadetblue.darker());
-    
-    auto waveform = audioProcessor.getWaveForm();
-    
-    if (waveform.getNumSamples() > 0) {
-        juce::Path p;
-        mAudioPoints.clear();
-        
-        
-        auto ratio = waveform.getNumSamples() / getWidth();
-        auto buffer = waveform.getReadPointer(0);
-        
-        // Scale audio file to window on x axis
-        for (int sample = 0; sample < waveform.getNumSamples(); sample += ratio) {
-            mAudioPoints.push_back(buffer[sample]);
-        }
-        
-        g.setColour(juce::Colours::white);
-        p.startNewSubPath(0, getHeight() / 2);
-        
-        // Scale audio on y axis
-        for (int sample = 0; sample < mAudioPoints.size(); ++sample) {
-            auto point = juce::jmap<float>(mAudioPoints[sample], -1.f, 1.f, getHeight(), 0);
-            p.lineTo(sample, point);
-        }
-        
-        g.strokePath(p, juce::PathStrokeType(2));
-        
-        g.setColour(juce::Colours::white);
-        g.setFont(15.f);
-        auto textBounds = getLocalBounds().reduced(10, 10);
-        g.drawFittedText(mFileName, textBounds, juce::Justification::topRight, 1);
-
-        auto playHeadPosition = juce::jmap<int>(audioProcessor.getSampleCount(), 0, audioProcessor.getWaveForm().getNumSamples(), 0, getWidth());
-        
-        g.setColour(juce::Colours::white);
-        g.drawLine(playHeadPosition, 0, playHeadPosition, getHeight(), 2.f);
-        
-        g.setColour(juce::Colours::black.withAlpha(0.2f));
-        g.fillRect(0, 0, playHeadPosition, getHeight());
-    } else {
-        g.setColour(juce::Colours::white);
-        g.setFont(40.f);
-        g.drawFittedText("Drop an Audio File to Load", getLocalBounds(), juce::Justification::centred, 1);
-    }
-}
-
-void WaveThumbnail::resized()
-{
-    // This method is where you should set the bounds of any child
-    // components that your component contains..
-
-}
-
-bool WaveThumbnail::isInterestedInFileDrag (const juce::StringArray& files)
-{
-    for (auto file : files) {
-        if (file.contains(".wav") || file.contains(".mp3") || file.contains(".aif")) {
-            return true;
-        }
-    }
-    
-    return false;
-}
-
-void WaveThumbnail::filesDropped(const juce::StringArray& files, int x, int y)
-{
-    for (auto file : files) {
-        if (isInterestedInFileDrag(file)) {
-            auto myFile = std::make_unique<juce::File> (file);
-            mFileName = myFile->getFileNameWithoutExtension();
-            audioProcessor.loadFile(file);
-        }
-    }
-    repaint();
-}
+/*
+  ==============================================================================
+
+    WaveThumbnail.cpp
+    Created: 4 Feb 2024 6:14:19pm
+    Author:  Adam Chung
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "WaveThumbnail.h"
+
+//==============================================================================
+WaveThumbnail::WaveThumbnail(BasicSamplerAudioProcessor& p) : audioProcessor(p)
+{
+    // In your constructor, you should add any child components, and
+    // initialise any special settings that your component needs.
+    audioProcessor.addChangeListener(this);
+}
+
+WaveThumbnail::~WaveThumbnail()
+{
+    audioProcessor.removeChangeListener(this);
+}
+
+void WaveThumbnail::paint (juce::Graphics& g)
+{
+    const auto& peaks = audioProcessor.getPeaks();
+    
+    if (!peaks.isEmpty()) {
+        auto scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+        
+        if (!mCacheIsValid || mWaveformCache.getWidth() != juce::roundToInt(getWidth() * scale)) {
+            renderWaveformCache(scale);
+        }
+        
+        g.drawImage(mWaveformCache, getLocalBounds().toFloat());
+        
+        g.setColour(juce::Colours::white);
+        g.setFont(15.f);
+        auto textBounds = getLocalBounds().reduced(10, 10);
+        g.drawFittedText(mFileName, textBounds, juce::Justification::topRight, 1);
+        
+        if (auto underruns = audioProcessor.getNumStreamUnderruns(); underruns > 0) {
+            g.setColour(juce::Colours::orange);
+            g.drawFittedText("Disk underruns: " + juce::String(underruns), textBounds, juce::Justification::bottomRight, 1);
+        }
+        
+        // Fade each voice's playhead with its envelope so release tails read as such
+        for (const auto& playhead : mPlayheads) {
+            if (playhead.x >= 0) {
+                g.setColour(juce::Colours::white.withAlpha(juce::jlimit(0.2f, 1.f, playhead.level)));
+                g.drawLine(playhead.x, 0, playhead.x, getHeight(), 2.f);
+            }
+        }
+    } else {
+        g.fillAll(juce::Colours::cadetblue.darker());
+        g.setColour(juce::Colours::white);
+        g.setFont(40.f);
+        g.drawFittedText("Drop an Audio File to Load", getLocalBounds(), juce::Justification::centred, 1);
+    }
+}
+
+void WaveThumbnail::renderWaveformCache(float scale)
+{
+    auto width = juce::jmax(1, juce::roundToInt(getWidth() * scale));
+    auto height = juce::jmax(1, juce::roundToInt(getHeight() * scale));
+    
+    mWaveformCache = juce::Image(juce::Image::RGB, width, height, false);
+    juce::Graphics g(mWaveformCache);
+    g.fillAll(juce::Colours::cadetblue.darker());
+    
+    // One summary per pixel column, so this costs the same for any file length
+    const auto& peaks = audioProcessor.getPeaks();
+    mPixelPeaks.resize(static_cast<size_t>(width));
+    peaks.getPeaks(0, peaks.getNumSamples(), mPixelPeaks.data(), width);
+    
+    auto toY = [height] (float value) { return juce::jmap<float>(value, -1.f, 1.f, static_cast<float>(height), 0.f); };
+    
+    g.setColour(juce::Colours::white);
+    for (int x = 0; x < width; ++x) {
+        const auto& peak = mPixelPeaks[static_cast<size_t>(x)];
+        g.drawVerticalLine(x, toY(peak.max), toY(peak.min) + 1.f);
+    }
+    
+    g.setColour(juce::Colours::cadetblue.brighter());
+    for (int x = 0; x < width; ++x) {
+        const auto& peak = mPixelPeaks[static_cast<size_t>(x)];
+        g.drawVerticalLine(x, toY(peak.rms), toY(-peak.rms) + 1.f);
+    }
+    
+    mCacheIsValid = true;
+}
+
+int WaveThumbnail::toPlayheadX(double sourcePosition) const
+{
+    auto numSamples = audioProcessor.getPeaks().getNumSamples();
+    
+    if (numSamples <= 0) {
+        return -1;
+    }
+    
+    auto position = sourcePosition / static_cast<double>(numSamples);
+    return juce::roundToInt(juce::jlimit(0.0, 1.0, position) * getWidth());
+}
+
+void WaveThumbnail::repaintPlayheadStrip(int x)
+{
+    // Covers the line's stroke width
+    if (x >= 0) {
+        repaint(x - 2, 0, 4, getHeight());
+    }
+}
+
+void WaveThumbnail::updatePlayhead()
+{
+    const auto& playheads = audioProcessor.getPlayheads();
+    
+    for (int i = 0; i < playheads.getNumVoices(); ++i) {
+        auto state = playheads.read(i);
+        auto& drawn = mPlayheads[static_cast<size_t>(i)];
+        auto newX = state.active ? toPlayheadX(state.position) : -1;
+        
+        // Only bother with level changes big enough to see
+        if (newX != drawn.x || std::abs(state.level - drawn.level) > 0.05f) {
+            repaintPlayheadStrip(drawn.x);
+            repaintPlayheadStrip(newX);
+            drawn.x = newX;
+            drawn.level = state.level;
+        }
+    }
+    
+    if (auto underruns = audioProcessor.getNumStreamUnderruns(); underruns != mLastUnderruns) {
+        mLastUnderruns = underruns;
+        repaint(getLocalBounds().reduced(10, 10).removeFromBottom(20));
+    }
+}
+
+bool WaveThumbnail::hasActivePlayheads() const
+{
+    return std::any_of(mPlayheads.begin(), mPlayheads.end(), [] (const DrawnPlayhead& p) { return p.x >= 0; });
+}
+
+void WaveThumbnail::resized()
+{
+    // This method is where you should set the bounds of any child
+    // components that your component contains..
+    mCacheIsValid = false;
+}
+
+bool WaveThumbnail::isInterestedInFileDrag (const juce::StringArray& files)
+{
+    for (auto file : files) {
+        if (file.contains(".wav") || file.contains(".mp3") || file.contains(".aif") || file.contains(".sfz")
+            || juce::File (file).isDirectory()) {
+            return true;
+        }
+    }
+    
+    return false;
+}
+
+void WaveThumbnail::filesDropped(const juce::StringArray& files, int x, int y)
+{
+    for (auto file : files) {
+        if (isInterestedInFileDrag(file)) {
+            auto myFile = std::make_unique<juce::File> (file);
+            mFileName = myFile->getFileNameWithoutExtension();
+            audioProcessor.loadFile(file);
+        }
+    }
+    repaint();
+}
+
+void WaveThumbnail::changeListenerCallback(juce::ChangeBroadcaster* source)
+{
+    // A sample finished loading in the background
+    mCacheIsValid = false;
+    repaint();
+}
@@ -1,41 +1,65 @@
-/*
-  ==============================================================================
-
-    WaveThumbnail.h
-    Created: 4 Feb 2024 6:14:19pm
-    Author:  Adam Chung
-
-  ==============================================================================
-*/
-
-#pragma once
-
-#include <JuceHeader.h>
-#include "PluginProcessor.h"
-
-//==============================================================================
-/*
-*/
-class WaveThumbnail  : public juce::Component,
-                       public juce::FileDragAndDropTarget
-{
-public:
-    WaveThumbnail(BasicSamplerAudioProcessor& p);
-    ~WaveThumbnail() override;
-
-    void paint (juce::Graphics&) override;
-    void resized() override;
-    
-    bool isInterestedInFileDrag(const juce::StringArray& files) override;
-    void filesDropped (const juce::StringArray& files, int x, int y) override;
-
-private:
-    std::vector<float> mAudioPoints;
-    bool mShouldBePainting { false };
-    
-    juce::String mFileName {""};
-    
-    BasicSamplerAudioProcessor& audioProcessor;
-    
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (WaveThumbnail)
-};
+/*
+  ==============================================================================
+
+    WaveThumbnail.h
+    Created: 4 Feb 2024 6:14:19pm
+    Author:  Adam Chung
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+
+//==============================================================================
+/*
+*/
+class WaveThumbnail  : public juce::Component,
+                       public juce::FileDragAndDropTarget,
+                       public juce::ChangeListener
+{
+public:
+    WaveThumbnail(BasicSamplerAudioProcessor& p);
+    ~WaveThumbnail() override;
+
+    void paint (juce::Graphics&) override;
+    void resized() override;
+    
+    bool isInterestedInFileDrag(const juce::StringArray& files) override;
+    void filesDropped (const juce::StringArray& files, int x, int y) override;
+    
+    void changeListenerCallback (juce::ChangeBroadcaster* source) override;
+    
+    // Repaints only the strips the voice playheads moved across
+    void updatePlayhead();
+    bool hasActivePlayheads() const;
+
+private:
+    void renderWaveformCache (float scale);
+    int toPlayheadX (double sourcePosition) const;
+    void repaintPlayheadStrip (int x);
+    
+    std::vector<PeakPyramid::Peak> mPixelPeaks;
+    
+    // The waveform only changes on load or resize, everything else is drawn over it
+    juce::Image mWaveformCache;
+    bool mCacheIsValid { false };
+    
+    // One playhead per voice, -1 while the voice is idle
+    struct DrawnPlayhead
+    {
+        int x { -1 };
+        float level { 0.0f };
+    };
+    
+    std::array<DrawnPlayhead, VoicePlayheads::maxVoices> mPlayheads;
+    int mLastUnderruns { 0 };
+    
+    juce::String mFileName {""};
+    
+    BasicSamplerAudioProcessor& audioProcessor;
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (WaveThumbnail)
+};
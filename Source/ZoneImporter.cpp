@@ -0,0 +1,309 @@
+/*
+  ==============================================================================
+
+    ZoneImporter.cpp
+    Created: 17 Oct 2026 8:54:47pm
+    Author:  Adam Chung
+
+  ==============================================================================
+*/
+
+#include "ZoneImporter.h"
+
+namespace
+{
+    int parseNoteName (const juce::String& text)
+    {
+        static constexpr int pitchClasses[] { 9, 11, 0, 2, 4, 5, 7 };   // a to g
+
+        auto s = text.trim().toLowerCase();
+
+        if (s.length() < 2 || s[0] < 'a' || s[0] > 'g') {
+            return -1;
+        }
+
+        auto note = pitchClasses[s[0] - 'a'];
+        auto rest = s.substring (1);
+
+        if (rest.startsWithChar ('#')) {
+            ++note;
+            rest = rest.substring (1);
+        } else if (rest.startsWithChar ('b') && rest.length() > 1) {
+            --note;
+            rest = rest.substring (1);
+        }
+
+        if (!rest.containsOnly ("-0123456789") || rest.isEmpty() || rest == "-") {
+            return -1;
+        }
+
+        auto midi = (rest.getIntValue() + 1) * 12 + note;
+        return juce::isPositiveAndBelow (midi, 128) ? midi : -1;
+    }
+
+    int parsePrefixedNumber (const juce::String& token, const juce::String& prefix)
+    {
+        auto lower = token.toLowerCase();
+
+        if (!lower.startsWith (prefix)) {
+            return -1;
+        }
+
+        auto digits = lower.substring (prefix.length());
+        return digits.isNotEmpty() && digits.containsOnly ("0123456789") ? digits.getIntValue() : -1;
+    }
+
+    //==============================================================================
+    void applyOpcode (ZoneMap::Description& zone, const juce::String& opcode, const juce::String& value,
+                      const juce::File& sampleFolder)
+    {
+        auto note = [&value] { return ZoneImporter::parseNote (value); };
+
+        if (opcode == "sample") {
+            zone.file = sampleFolder.getChildFile (value.replaceCharacter ('\\', '/'));
+        } else if (opcode == "lokey") {
+            zone.loKey = note();
+        } else if (opcode == "hikey") {
+            zone.hiKey = note();
+        } else if (opcode == "key") {
+            zone.loKey = zone.hiKey = zone.rootKey = note();
+        } else if (opcode == "pitch_keycenter") {
+            zone.rootKey = note();
+        } else if (opcode == "lovel") {
+            zone.loVelocity = value.getIntValue();
+        } else if (opcode == "hivel") {
+            zone.hiVelocity = value.getIntValue();
+        } else if (opcode == "seq_length") {
+            zone.seqLength = value.getIntValue();
+        } else if (opcode == "seq_position") {
+            zone.seqPosition = value.getIntValue();
+        }
+    }
+
+    bool isValid (const ZoneMap::Description& zone)
+    {
+        return zone.file.existsAsFile()
+            && zone.loKey >= 0 && zone.hiKey >= zone.loKey
+            && zone.rootKey >= 0
+            && zone.hiVelocity >= zone.loVelocity;
+    }
+}
+
+//==============================================================================
+int ZoneImporter::parseNote (const juce::String& text)
+{
+    auto trimmed = text.trim();
+
+    if (trimmed.isNotEmpty() && trimmed.containsOnly ("0123456789")) {
+        auto number = trimmed.getIntValue();
+        return juce::isPositiveAndBelow (number, 128) ? number : -1;
+    }
+
+    return parseNoteName (trimmed);
+}
+
+bool ZoneImporter::isInstrumentFile (const juce::File& file)
+{
+    return file.hasFileExtension ("sfz");
+}
+
+std::vector<ZoneMap::Description> ZoneImporter::import (const juce::File& fileOrFolder, juce::AudioFormatManager& formatManager)
+{
+    if (fileOrFolder.isDirectory()) {
+        return importFolder (fileOrFolder, formatManager);
+    }
+
+    if (isInstrumentFile (fileOrFolder)) {
+        return importSfz (fileOrFolder);
+    }
+
+    ZoneMap::Description zone;
+    zone.file = fileOrFolder;
+    return { zone };
+}
+
+std::vector<ZoneMap::Description> ZoneImporter::importSfz (const juce::File& sfzFile)
+{
+    enum Level { control, global, master, group, region, numLevels };
+
+    // Opcodes set at each header level, the levels below inherit them
+    std::array<juce::StringPairArray, numLevels> opcodes;
+    auto level = global;
+
+    std::vector<ZoneMap::Description> zones;
+    auto baseFolder = sfzFile.getParentDirectory();
+
+    auto emitRegion = [&] {
+        ZoneMap::Description zone;
+        auto sampleFolder = baseFolder.getChildFile (opcodes[control].getValue ("default_path", {}).replaceCharacter ('\\', '/'));
+
+        for (int l = global; l <= region; ++l) {
+            const auto& set = opcodes[static_cast<size_t> (l)];
+
+            for (int i = 0; i < set.size(); ++i) {
+                applyOpcode (zone, set.getAllKeys()[i], set.getAllValues()[i], sampleFolder);
+            }
+        }
+
+        if (isValid (zone)) {
+            zones.push_back (zone);
+        }
+    };
+
+    auto startLevel = [&] (Level newLevel) {
+        if (level == region) {
+            emitRegion();
+        }
+
+        level = newLevel;
+
+        // A new header forgets what its own level and everything below it set
+        for (int l = newLevel; l < numLevels; ++l) {
+            opcodes[static_cast<size_t> (l)].clear();
+        }
+    };
+
+    juce::StringArray lines;
+    lines.addLines (sfzFile.loadFileAsString());
+
+    for (auto line : lines) {
+        line = line.upToFirstOccurrenceOf ("//", false, false);
+
+        // Headers can share a line with opcodes, so give them their own tokens
+        auto tokens = juce::StringArray::fromTokens (line.replace ("<", " <").replace (">", "> "), " \t", {});
+
+        juce::String opcode, value;
+
+        auto flushOpcode = [&] {
+            if (opcode.isNotEmpty()) {
+                opcodes[static_cast<size_t> (level)].set (opcode, value);
+            }
+
+            opcode.clear();
+            value.clear();
+        };
+
+        for (auto& token : tokens) {
+            if (token.startsWithChar ('<') && token.endsWithChar ('>')) {
+                flushOpcode();
+                auto header = token.substring (1, token.length() - 1);
+
+                if (header == "control")     { startLevel (control); }
+                else if (header == "global") { startLevel (global); }
+                else if (header == "master") { startLevel (master); }
+                else if (header == "group")  { startLevel (group); }
+                else if (header == "region") { startLevel (region); }
+            } else if (token.containsChar ('=')) {
+                flushOpcode();
+                opcode = token.upToFirstOccurrenceOf ("=", false, false).toLowerCase();
+                value = token.fromFirstOccurrenceOf ("=", false, false);
+            } else if (opcode.isNotEmpty()) {
+                // Sample paths may contain spaces, everything up to the next opcode belongs to them
+                value << " " << token;
+            }
+        }
+
+        flushOpcode();
+    }
+
+    if (level == region) {
+        emitRegion();
+    }
+
+    return zones;
+}
+
+std::vector<ZoneMap::Description> ZoneImporter::importFolder (const juce::File& folder, juce::AudioFormatManager& formatManager)
+{
+    struct Sample
+    {
+        juce::File file;
+        int root;
+        int layer;
+        int roundRobin;
+    };
+
+    std::vector<Sample> samples;
+
+    for (const auto& entry : juce::RangedDirectoryIterator (folder, false, formatManager.getWildcardForAllFormats())) {
+        Sample sample { entry.getFile(), -1, 0, 0 };
+        auto tokens = juce::StringArray::fromTokens (sample.file.getFileNameWithoutExtension(), "_- .", {});
+
+        for (auto& token : tokens) {
+            if (auto layer = juce::jmax (parsePrefixedNumber (token, "vel"), parsePrefixedNumber (token, "v")); layer >= 0) {
+                sample.layer = layer;
+            } else if (auto roundRobin = parsePrefixedNumber (token, "rr"); roundRobin >= 0) {
+                sample.roundRobin = roundRobin;
+            } else if (auto note = parseNoteName (token); note >= 0) {
+                sample.root = note;
+            }
+        }
+
+        if (sample.root >= 0) {
+            samples.push_back (sample);
+        }
+    }
+
+    std::sort (samples.begin(), samples.end(), [] (const Sample& a, const Sample& b) {
+        return std::tie (a.root, a.layer, a.roundRobin) < std::tie (b.root, b.layer, b.roundRobin);
+    });
+
+    std::vector<int> roots;
+
+    for (auto& s : samples) {
+        if (roots.empty() || roots.back() != s.root) {
+            roots.push_back (s.root);
+        }
+    }
+
+    std::vector<ZoneMap::Description> zones;
+
+    for (size_t r = 0; r < roots.size(); ++r) {
+        // Each root covers the keys up to halfway to its neighbours
+        auto loKey = r == 0 ? 0 : (roots[r - 1] + roots[r]) / 2 + 1;
+        auto hiKey = r + 1 == roots.size() ? 127 : (roots[r] + roots[r + 1]) / 2;
+
+        std::vector<const Sample*> rootSamples;
+
+        for (auto& s : samples) {
+            if (s.root == roots[r]) {
+                rootSamples.push_back (&s);
+            }
+        }
+
+        std::vector<int> layers;
+
+        for (auto* s : rootSamples) {
+            if (layers.empty() || layers.back() != s->layer) {
+                layers.push_back (s->layer);
+            }
+        }
+
+        for (size_t l = 0; l < layers.size(); ++l) {
+            std::vector<const Sample*> variations;
+
+            for (auto* s : rootSamples) {
+                if (s->layer == layers[l]) {
+                    variations.push_back (s);
+                }
+            }
+
+            auto numLayers = static_cast<int> (layers.size());
+
+            for (size_t v = 0; v < variations.size(); ++v) {
+                ZoneMap::Description zone;
+                zone.file = variations[v]->file;
+                zone.rootKey = roots[r];
+                zone.loKey = loKey;
+                zone.hiKey = hiKey;
+                zone.loVelocity = 1 + 127 * static_cast<int> (l) / numLayers;
+                zone.hiVelocity = 127 * (static_cast<int> (l) + 1) / numLayers;
+                zone.seqLength = static_cast<int> (variations.size());
+                zone.seqPosition = static_cast<int> (v) + 1;
+                zones.push_back (zone);
+            }
+        }
+    }
+
+    return zones;
+}
@@ -0,0 +1,39 @@
+/*
+  ==============================================================================
+
+    ZoneImporter.h
+    Created: 17 Oct 2026 8:54:47pm
+    Author:  Adam Chung
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "ZoneMap.h"
+
+//==============================================================================
+/*
+    Turns what the user loaded into zone descriptions, without touching any
+    audio data:
+
+      - a single audio file becomes one zone across the keyboard, rooted at 60
+      - an SFZ file's regions become zones (the key, velocity and round-robin
+        opcodes, with <global>, <master> and <group> inheritance)
+      - a folder becomes one zone per audio file, laid out from names like
+        "Piano_C#4_v2_rr3.wav": a note name sets the root, "v" tokens are
+        velocity layers and "rr" tokens round-robin variations
+*/
+namespace ZoneImporter
+{
+    std::vector<ZoneMap::Description> import (const juce::File& fileOrFolder, juce::AudioFormatManager& formatManager);
+
+    std::vector<ZoneMap::Description> importSfz (const juce::File& sfzFile);
+    std::vector<ZoneMap::Description> importFolder (const juce::File& folder, juce::AudioFormatManager& formatManager);
+
+    bool isInstrumentFile (const juce::File& file);
+
+    // "c4", "C#4", "Db-1" or a plain number. C4 is 60, as in SFZ. Returns -1 if it's neither.
+    int parseNote (const juce::String& text);
+}
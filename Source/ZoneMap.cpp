@@ -0,0 +1,72 @@
+/*
+  ==============================================================================
+
+    ZoneMap.cpp
+    Created: 17 Oct 2026 8:31:05pm
+    Author:  Adam Chung
+
+  ==============================================================================
+*/
+
+#include "ZoneMap.h"
+
+//==============================================================================
+ZoneMap::ZoneMap (const std::vector<Description>& descriptions,
+                  const std::vector<juce::ReferenceCountedObjectPtr<StreamingSamplerSound>>& sounds)
+{
+    constexpr size_t numCells = 128 * 128;
+    constexpr size_t maxZones = std::numeric_limits<juce::uint16>::max();
+
+    std::vector<const Description*> used;
+
+    for (size_t i = 0; i < descriptions.size() && i < sounds.size() && mZones.size() < maxZones; ++i) {
+        auto* sound = sounds[i].get();
+
+        if (sound == nullptr) {
+            continue;
+        }
+
+        const auto& d = descriptions[i];
+
+        Zone zone;
+        zone.sound = sound;
+        zone.seqLength = static_cast<juce::uint8> (juce::jlimit (1, 255, d.seqLength));
+        zone.seqPosition = static_cast<juce::uint8> (juce::jlimit (1, static_cast<int> (zone.seqLength), d.seqPosition) - 1);
+
+        mZones.push_back (zone);
+        mSounds.add (sound);
+        used.push_back (&d);
+    }
+
+    // Counting pass, then fill, so every cell's zones end up next to each other
+    mCellStart.assign (numCells + 1, 0);
+
+    auto forEachCell = [&used] (auto&& fn) {
+        for (size_t z = 0; z < used.size(); ++z) {
+            const auto& d = *used[z];
+
+            for (int note = juce::jmax (0, d.loKey); note <= juce::jmin (127, d.hiKey); ++note) {
+                for (int vel = juce::jmax (0, d.loVelocity); vel <= juce::jmin (127, d.hiVelocity); ++vel) {
+                    fn (static_cast<size_t> ((note << 7) | vel), z);
+                }
+            }
+        }
+    };
+
+    forEachCell ([this] (size_t cell, size_t) { ++mCellStart[cell + 1]; });
+
+    for (size_t cell = 0; cell < numCells; ++cell) {
+        mCellStart[cell + 1] += mCellStart[cell];
+    }
+
+    mCellZones.resize (mCellStart[numCells]);
+    std::vector<juce::uint32> fill (mCellStart.begin(), mCellStart.end() - 1);
+
+    forEachCell ([this, &fill] (size_t cell, size_t zone) {
+        mCellZones[fill[cell]++] = static_cast<juce::uint16> (zone);
+    });
+}
+
+ZoneMap::~ZoneMap()
+{
+}
@@ -0,0 +1,95 @@
+/*
+  ==============================================================================
+
+    ZoneMap.h
+    Created: 17 Oct 2026 8:31:05pm
+    Author:  Adam Chung
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "StreamingSamplerSound.h"
+
+//==============================================================================
+/*
+    Which sounds a note-on plays: a set of zones, each a sample with a key
+    range, a velocity range and an optional round-robin slot.
+
+    A map is built once, off the audio thread, and never changes afterwards,
+    apart from the round-robin counters the audio thread advances. Finding a
+    note's zones is one lookup in a flat 128 x 128 (note, velocity) table into
+    a shared array of zone indices, so it costs the same however many zones the
+    instrument has.
+*/
+class ZoneMap  : public juce::ReferenceCountedObject
+{
+public:
+    using Ptr = juce::ReferenceCountedObjectPtr<ZoneMap>;
+
+    // A zone before its sample has been loaded, as read from a folder or an SFZ file
+    struct Description
+    {
+        juce::File file;
+        int loKey { 0 };
+        int hiKey { 127 };
+        int rootKey { 60 };
+        int loVelocity { 1 };
+        int hiVelocity { 127 };
+
+        // Round robin, like SFZ's seq_length/seq_position: the zone plays on
+        // every seqLength-th hit of its key, starting with hit seqPosition.
+        int seqLength { 1 };
+        int seqPosition { 1 };
+    };
+
+    struct Zone
+    {
+        StreamingSamplerSound* sound { nullptr };
+        juce::uint8 seqLength { 1 };
+        juce::uint8 seqPosition { 0 };   // zero based
+    };
+
+    // sounds[i] is the loaded sample of descriptions[i], null entries are skipped
+    ZoneMap (const std::vector<Description>& descriptions,
+             const std::vector<juce::ReferenceCountedObjectPtr<StreamingSamplerSound>>& sounds);
+    ~ZoneMap() override;
+
+    int getNumZones() const { return static_cast<int> (mZones.size()); }
+    const juce::ReferenceCountedArray<StreamingSamplerSound>& getSounds() const { return mSounds; }
+
+    // Audio thread only, as it advances the key's round-robin counter. Calls
+    // callback (const Zone&) for every zone that should sound.
+    template <typename Callback>
+    void forEachZone (int midiNoteNumber, int velocity, Callback&& callback)
+    {
+        if (!juce::isPositiveAndBelow (midiNoteNumber, 128) || !juce::isPositiveAndBelow (velocity, 128)) {
+            return;
+        }
+
+        auto cell = static_cast<size_t> ((midiNoteNumber << 7) | velocity);
+        auto hit = mRoundRobin[static_cast<size_t> (midiNoteNumber)]++;
+
+        for (auto i = mCellStart[cell]; i < mCellStart[cell + 1]; ++i) {
+            const auto& zone = mZones[mCellZones[i]];
+
+            if (zone.seqLength <= 1 || hit % zone.seqLength == zone.seqPosition) {
+                callback (zone);
+            }
+        }
+    }
+
+private:
+    std::vector<Zone> mZones;
+    juce::ReferenceCountedArray<StreamingSamplerSound> mSounds;
+
+    // Zones of cell (note << 7 | velocity) are mCellZones[mCellStart[cell] .. mCellStart[cell + 1])
+    std::vector<juce::uint32> mCellStart;
+    std::vector<juce::uint16> mCellZones;
+
+    std::array<juce::uint32, 128> mRoundRobin {};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ZoneMap)
+};